@@ -0,0 +1,205 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   bench.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_BENCH_HPP
+#define STATICLIB_WEBSOCKET_BENCH_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/**
+ * Prevents the compiler from optimizing away the computation
+ * of the specified value
+ *
+ * @param val value
+ */
+template<typename T>
+inline void do_not_optimize(const T& val) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(val) : "memory");
+#else
+    static volatile const void* sink = nullptr;
+    sink = static_cast<const void*>(&val);
+#endif
+}
+
+/**
+ * Parameters of a single benchmark case (name-value pairs)
+ */
+typedef std::vector<std::pair<std::string, std::string>> params_type;
+
+/**
+ * Result of a single benchmark case
+ */
+struct result {
+    std::string name;
+    params_type params;
+    uint64_t iterations;
+    double ns_per_op;
+    uint64_t bytes_per_op;
+};
+
+/**
+ * Set of benchmark cases of a single executable, each case is calibrated
+ * to run for at least the specified time, results are written in JSON
+ */
+class suite {
+    std::string suite_name;
+    std::string filter;
+    std::string out_path;
+    double min_time_ns = 200.0 * 1000 * 1000;
+    std::vector<result> results;
+
+public:
+    /**
+     * Constructor, recognized arguments:
+     * `--filter=<substring>` - run only cases whose name contains the substring,
+     * `--min-time-ms=<ms>` - min measurement time for each case (200 by default),
+     * `--out=<path>` - write JSON into the specified file instead of stdout
+     *
+     * @param name suite name
+     * @param argc number of command line arguments
+     * @param argv command line arguments
+     */
+    suite(const std::string& name, int argc, char** argv) :
+    suite_name(name) {
+        for (int i = 1; i < argc; i++) {
+            auto arg = std::string(argv[i]);
+            if (0 == arg.find("--filter=")) {
+                this->filter = arg.substr(9);
+            } else if (0 == arg.find("--min-time-ms=")) {
+                this->min_time_ns = std::stod(arg.substr(14)) * 1000 * 1000;
+            } else if (0 == arg.find("--out=")) {
+                this->out_path = arg.substr(6);
+            }
+        }
+    }
+
+    /**
+     * Runs the benchmark case, the number of iterations is doubled
+     * until the run takes at least the min measurement time
+     *
+     * @param name case name
+     * @param params case parameters
+     * @param bytes_per_op number of payload bytes processed by each iteration,
+     *        used to compute the throughput
+     * @param fun functor called as `fun(iterations)`, must run the measured
+     *        operation the specified number of times
+     */
+    template<typename Fun>
+    void run(const std::string& name, const params_type& params, uint64_t bytes_per_op, Fun fun) {
+        if (!filter.empty() && std::string::npos == name.find(filter)) {
+            return;
+        }
+        // warm-up
+        fun(1);
+        uint64_t iters = 1;
+        double elapsed = 0;
+        for (;;) {
+            auto start = std::chrono::steady_clock::now();
+            fun(iters);
+            auto end = std::chrono::steady_clock::now();
+            elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            if (elapsed >= min_time_ns || iters >= (1ULL << 40)) {
+                break;
+            }
+            iters *= 2;
+        }
+        auto res = result();
+        res.name = name;
+        res.params = params;
+        res.iterations = iters;
+        res.ns_per_op = elapsed / static_cast<double>(iters);
+        res.bytes_per_op = bytes_per_op;
+        std::cerr << suite_name << "/" << name << format_params(params) << ": " <<
+                res.ns_per_op << " ns/op" << std::endl;
+        results.emplace_back(std::move(res));
+    }
+
+    /**
+     * Writes collected results in JSON format
+     *
+     * @return `0` on success, `1` if output file cannot be written
+     */
+    int finish() {
+        auto json = to_json();
+        if (out_path.empty()) {
+            std::cout << json << std::endl;
+            return 0;
+        }
+        std::ofstream out(out_path.c_str());
+        out << json << std::endl;
+        return out.good() ? 0 : 1;
+    }
+
+private:
+    static std::string format_params(const params_type& params) {
+        auto st = std::string();
+        for (auto& pa : params) {
+            st += "/" + pa.first + "=" + pa.second;
+        }
+        return st;
+    }
+
+    static std::string quote(const std::string& st) {
+        auto res = std::string("\"");
+        for (char ch : st) {
+            if ('"' == ch || '\\' == ch) {
+                res.push_back('\\');
+            }
+            res.push_back(ch);
+        }
+        res.push_back('"');
+        return res;
+    }
+
+    std::string to_json() const {
+        auto ss = std::ostringstream();
+        ss << "{\n  \"suite\": " << quote(suite_name) << ",\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            auto& res = results[i];
+            ss << (i > 0 ? "," : "") << "\n    {\"name\": " << quote(res.name) << ", \"params\": {";
+            for (size_t j = 0; j < res.params.size(); j++) {
+                ss << (j > 0 ? ", " : "") << quote(res.params[j].first) << ": " << quote(res.params[j].second);
+            }
+            double bytes_per_sec = res.ns_per_op > 0 ?
+                    static_cast<double>(res.bytes_per_op) * 1e9 / res.ns_per_op : 0;
+            double ops_per_sec = res.ns_per_op > 0 ? 1e9 / res.ns_per_op : 0;
+            ss << "}, \"iterations\": " << res.iterations <<
+                    ", \"ns_per_op\": " << res.ns_per_op <<
+                    ", \"ops_per_sec\": " << static_cast<uint64_t>(ops_per_sec) <<
+                    ", \"bytes_per_sec\": " << static_cast<uint64_t>(bytes_per_sec) << "}";
+        }
+        ss << "\n  ]\n}";
+        return ss.str();
+    }
+};
+
+} // namespace
+
+#endif /* STATICLIB_WEBSOCKET_BENCH_HPP */
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   broadcast_bench.cpp
+ */
+
+#include "staticlib/websocket/broadcast_hub.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/encoded_frame.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const std::vector<size_t> subscribers = {1, 100, 10000, 100000};
+
+const std::string payload = std::string(125, 'a');
+
+bench::params_type make_params(size_t count) {
+    return {
+        {"subscribers", sl::support::to_string(count)},
+        {"size", sl::support::to_string(payload.length())}
+    };
+}
+
+// shared frame is encoded once and passed to each send queue by reference
+void bench_shared(bench::suite& su) {
+    for (size_t count : subscribers) {
+        auto hub = sl::websocket::broadcast_hub<size_t>();
+        for (size_t i = 0; i < count; i++) {
+            hub.subscribe("topic", i);
+        }
+        auto queues = std::vector<std::shared_ptr<const sl::websocket::encoded_frame>>(count);
+        su.run("publish_shared", make_params(count), payload.length() * count, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto delivered = hub.publish("topic", sl::websocket::frame_type::text,
+                        {payload.data(), payload.length()},
+                        [&queues](size_t sub, const std::shared_ptr<const sl::websocket::encoded_frame>& fr) {
+                            queues[sub] = fr;
+                        });
+                bench::do_not_optimize(delivered);
+            }
+        });
+    }
+}
+
+// baseline: frame is encoded separately for each subscriber
+void bench_per_subscriber(bench::suite& su) {
+    for (size_t count : subscribers) {
+        auto hub = sl::websocket::broadcast_hub<size_t>();
+        for (size_t i = 0; i < count; i++) {
+            hub.subscribe("topic", i);
+        }
+        auto queues = std::vector<std::shared_ptr<const sl::websocket::encoded_frame>>(count);
+        su.run("publish_per_subscriber", make_params(count), payload.length() * count, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto delivered = hub.publish("topic", std::shared_ptr<const sl::websocket::encoded_frame>(),
+                        [&queues](size_t sub, const std::shared_ptr<const sl::websocket::encoded_frame>&) {
+                            queues[sub] = sl::websocket::make_encoded_frame(sl::websocket::frame_type::text,
+                                    {payload.data(), payload.length()});
+                        });
+                bench::do_not_optimize(delivered);
+            }
+        });
+    }
+}
+
+// per-publish cost of the hub itself: frame is already encoded, delivery is a counter
+void bench_dispatch(bench::suite& su) {
+    for (size_t count : {1, 100, 20000, 100000}) {
+        auto hub = sl::websocket::broadcast_hub<size_t>();
+        for (size_t i = 0; i < count; i++) {
+            hub.subscribe("topic", i);
+        }
+        auto frame = sl::websocket::make_encoded_frame(sl::websocket::frame_type::text,
+                {payload.data(), payload.length()});
+        size_t sum = 0;
+        su.run("publish_dispatch", make_params(count), 0, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto delivered = hub.publish("topic", frame,
+                        [&sum](size_t sub, const std::shared_ptr<const sl::websocket::encoded_frame>&) {
+                            sum += sub;
+                        });
+                bench::do_not_optimize(delivered);
+            }
+        });
+        bench::do_not_optimize(sum);
+    }
+}
+
+// all subscribers connect and then disconnect in arbitrary order
+void bench_churn(bench::suite& su) {
+    for (size_t count : subscribers) {
+        auto order = std::vector<size_t>();
+        for (size_t i = 0; i < count; i++) {
+            order.push_back((i * 7919) % count);
+        }
+        su.run("subscribe_unsubscribe_all", make_params(count), 0, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto hub = sl::websocket::broadcast_hub<size_t>();
+                for (size_t j = 0; j < count; j++) {
+                    hub.subscribe("topic", j);
+                }
+                for (size_t sub : order) {
+                    hub.unsubscribe_all(sub);
+                }
+                bench::do_not_optimize(hub.topics_count());
+            }
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("broadcast", argc, argv);
+        bench_shared(su);
+        bench_per_subscriber(su);
+        bench_dispatch(su);
+        bench_churn(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   buffer_pool_bench.cpp
+ */
+
+#include "staticlib/websocket/buffer_pool.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "staticlib/support.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+void bench_acquire(bench::suite& su) {
+    sl::websocket::buffer_pool pool;
+    sl::websocket::buffer_cache cache(pool);
+    for (size_t size : {125, 4096, 65536}) {
+        auto params = bench::params_type{{"size", sl::support::to_string(size)}};
+        su.run("heap_new_delete", params, 0, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto buf = std::unique_ptr<char[]>(new char[size]);
+                buf[0] = 'a';
+                bench::do_not_optimize(buf.get());
+            }
+        });
+        su.run("pool_acquire", params, 0, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto buf = pool.acquire(size);
+                buf.data()[0] = 'a';
+                bench::do_not_optimize(buf.data());
+            }
+        });
+        su.run("cache_acquire", params, 0, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto buf = cache.acquire(size);
+                buf.data()[0] = 'a';
+                bench::do_not_optimize(buf.data());
+            }
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("buffer_pool", argc, argv);
+        bench_acquire(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   control_bench.cpp
+ */
+
+#include "staticlib/websocket/control_frames.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/masked_payload_sink.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const uint32_t mask = 0x1875fdc8;
+
+std::string make_ping(size_t size) {
+    auto payload = std::string(size, 'p');
+    auto buf = std::array<char, 14>();
+    auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::ping, size, mask);
+    auto sink = sl::io::string_sink();
+    sink.write(head);
+    auto masker = sl::websocket::make_masked_payload_sink(sink, mask);
+    masker.write({payload.data(), payload.length()});
+    return std::move(sink.get_string());
+}
+
+// keepalive reply: parse the ping and build the pong
+void bench_pong(bench::suite& su) {
+    for (size_t size : {0, 8, 125}) {
+        auto ping = make_ping(size);
+        auto params = bench::params_type{{"size", sl::support::to_string(size)}};
+        su.run("make_pong", params, size, [&](uint64_t iters) {
+            auto buf = std::array<char, 127>();
+            for (uint64_t i = 0; i < iters; i++) {
+                auto fr = sl::websocket::frame({ping.data(), ping.length()});
+                auto pong = sl::websocket::control::make_pong(buf, fr);
+                bench::do_not_optimize(pong);
+            }
+        });
+        // baseline: header and unmasked payload are written into a string
+        su.run("make_pong_baseline", params, size, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto fr = sl::websocket::frame({ping.data(), ping.length()});
+                auto buf = std::array<char, 10>();
+                auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::pong,
+                        fr.payload_length());
+                auto sink = sl::io::string_sink();
+                sink.write(head);
+                auto src = fr.payload_unmasked();
+                sl::io::copy_all(src, sink);
+                bench::do_not_optimize(sink.get_string().front());
+            }
+        });
+    }
+}
+
+// server-initiated keepalive
+void bench_ping(bench::suite& su) {
+    su.run("ping_canned", {}, 0, [&](uint64_t iters) {
+        for (uint64_t i = 0; i < iters; i++) {
+            auto ping = sl::websocket::control::ping_frame();
+            bench::do_not_optimize(ping);
+        }
+    });
+    su.run("ping_make_header", {}, 0, [&](uint64_t iters) {
+        auto buf = std::array<char, 10>();
+        for (uint64_t i = 0; i < iters; i++) {
+            auto ping = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::ping, 0);
+            bench::do_not_optimize(ping);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("control", argc, argv);
+        bench_pong(su);
+        bench_ping(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
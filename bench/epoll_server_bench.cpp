@@ -0,0 +1,179 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   epoll_server_bench.cpp
+ */
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_LINUX
+
+#include "staticlib/websocket/epoll_server.hpp"
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/masked_payload_sink.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const uint32_t mask = 0x1875fdc8;
+
+class echo_handler {
+public:
+    void on_open(sl::websocket::epoll_connection&) { }
+
+    void on_message(sl::websocket::epoll_connection& conn, sl::websocket::frame_type type,
+            sl::io::span<const char> payload) {
+        conn.send(type, payload);
+    }
+
+    void on_close(sl::websocket::epoll_connection&, uint16_t) { }
+};
+
+// blocking client, that keeps a single message in flight
+class client {
+    int fd;
+    std::string request;
+    std::vector<char> response;
+
+public:
+    client(uint16_t port, size_t size) {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, std::addressof(one), sizeof(one));
+        struct sockaddr_in addr;
+        std::memset(std::addressof(addr), '\0', sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (0 != ::connect(fd, reinterpret_cast<struct sockaddr*>(std::addressof(addr)), sizeof(addr))) {
+            throw std::runtime_error("Connect error");
+        }
+        write(std::string() +
+                "GET / HTTP/1.1\r\n" +
+                "Host: localhost\r\n" +
+                "Upgrade: websocket\r\n" +
+                "Connection: Upgrade\r\n" +
+                "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n" +
+                "Sec-WebSocket-Version: 13\r\n" +
+                "\r\n");
+        read_exact(sl::websocket::handshake::response_length());
+        auto payload = std::string(size, 'a');
+        auto buf = std::array<char, 14>();
+        auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::binary, size, mask);
+        auto sink = sl::io::string_sink();
+        sink.write(head);
+        auto masker = sl::websocket::make_masked_payload_sink(sink, mask);
+        masker.write({payload.data(), payload.length()});
+        this->request = std::move(sink.get_string());
+        auto resp_buf = std::array<char, 10>();
+        auto resp_head = sl::websocket::frame::make_header(resp_buf, sl::websocket::frame_type::binary, size);
+        this->response.resize(resp_head.size() + size);
+    }
+
+    ~client() {
+        ::close(fd);
+    }
+
+    void roundtrip() {
+        write(request);
+        read_exact(response.size());
+    }
+
+private:
+    void write(const std::string& data) {
+        size_t written = 0;
+        while (written < data.length()) {
+            auto res = ::send(fd, data.data() + written, data.length() - written, MSG_NOSIGNAL);
+            if (res <= 0) {
+                throw std::runtime_error("Write error");
+            }
+            written += static_cast<size_t>(res);
+        }
+    }
+
+    void read_exact(size_t len) {
+        if (response.size() < len) {
+            response.resize(len);
+        }
+        size_t read = 0;
+        while (read < len) {
+            auto res = ::recv(fd, response.data() + read, len - read, 0);
+            if (res <= 0) {
+                throw std::runtime_error("Read error");
+            }
+            read += static_cast<size_t>(res);
+        }
+    }
+};
+
+void bench_echo(bench::suite& su, uint16_t port) {
+    for (size_t size : {16, 125, 1 << 16}) {
+        auto params = bench::params_type{{"size", sl::support::to_string(size)}};
+        client cl(port, size);
+        su.run("echo_roundtrip", params, size * 2, [&cl](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                cl.roundtrip();
+            }
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("epoll_server", argc, argv);
+        auto conf = sl::websocket::epoll_server_config();
+        conf.address = "127.0.0.1";
+        conf.port = 0;
+        conf.threads = 1;
+        echo_handler handler;
+        sl::websocket::epoll_server<echo_handler> server(conf, handler);
+        server.start();
+        bench_echo(su, server.port());
+        server.stop();
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
+
+#else // !STATICLIB_LINUX
+
+int main() {
+    return 0;
+}
+
+#endif // STATICLIB_LINUX
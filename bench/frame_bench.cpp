@@ -0,0 +1,358 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   frame_bench.cpp
+ */
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_encoder.hpp"
+#include "staticlib/websocket/frame_header.hpp"
+#include "staticlib/websocket/frame_parser.hpp"
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/message_assembler.hpp"
+#include "staticlib/websocket/segment_pool.hpp"
+#include "staticlib/websocket/utf8_validator.hpp"
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/masked_payload_sink.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const uint32_t mask = 0x1875fdc8;
+
+// typical TCP segment payload (MSS for 1500 MTU)
+const size_t chunk_size = 1460;
+
+const std::vector<size_t> sizes = {0, 125, 126, 1 << 16, 1 << 20, 1 << 24};
+
+bench::params_type make_params(size_t size, bool masked) {
+    return {
+        {"size", sl::support::to_string(size)},
+        {"masked", masked ? "true" : "false"}
+    };
+}
+
+std::string make_frame(sl::websocket::frame_type ft, size_t size, bool masked, bool partial = false) {
+    auto payload = std::string(size, 'a');
+    auto sink = sl::io::string_sink();
+    if (masked) {
+        auto buf = std::array<char, 14>();
+        auto head = sl::websocket::frame::make_header(buf, ft, size, mask, partial);
+        sink.write(head);
+        auto masker = sl::websocket::make_masked_payload_sink(sink, mask);
+        masker.write({payload.data(), payload.length()});
+    } else {
+        auto buf = std::array<char, 10>();
+        auto head = sl::websocket::frame::make_header(buf, ft, size, false, partial);
+        sink.write(head);
+        sink.write({payload.data(), payload.length()});
+    }
+    return std::move(sink.get_string());
+}
+
+// message split into the frames of chunk_size
+std::string make_message(size_t size, bool masked) {
+    auto res = std::string();
+    size_t pos = 0;
+    do {
+        size_t len = std::min(chunk_size, size - pos);
+        auto ft = 0 == pos ? sl::websocket::frame_type::binary : sl::websocket::frame_type::continuation;
+        res += make_frame(ft, len, masked, pos + len < size);
+        pos += len;
+    } while (pos < size);
+    return res;
+}
+
+size_t drain(sl::websocket::masked_payload_source& src, std::vector<char>& dest) {
+    size_t total = 0;
+    for (;;) {
+        auto read = src.read({dest.data() + total, dest.size() - total});
+        if (read <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(read);
+    }
+    return total;
+}
+
+// per-byte loop used by masked_payload_source before the bulk kernel
+void unmask_byte_loop(const char* src, char* dest, size_t len, uint32_t mask_val) {
+    for (size_t i = 0; i < len; i++) {
+        auto mask_byte = static_cast<char>((mask_val >> (8 * (3 - (i % 4)))) & 0xff);
+        dest[i] = src[i] ^ mask_byte;
+    }
+}
+
+void bench_unmask(bench::suite& su) {
+    auto dispatched = sl::websocket::detail_masking::choose_kernel();
+    for (size_t size : {16, 125, 256, 512, 1024, 2048, 4096, 1 << 16, 1 << 20}) {
+        auto src = std::string(size, 'a');
+        auto dest = std::vector<char>(size);
+        auto params = bench::params_type{{"size", sl::support::to_string(size)}};
+        su.run("unmask_byte_loop", params, size, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                unmask_byte_loop(src.data(), dest.data(), size, mask);
+                bench::do_not_optimize(dest.front());
+            }
+        });
+        su.run("unmask_scalar", params, size, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                sl::websocket::detail_masking::apply_mask_scalar(src.data(), dest.data(), size, mask, 0);
+                bench::do_not_optimize(dest.front());
+            }
+        });
+        su.run("unmask_dispatched", params, size, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                dispatched(src.data(), dest.data(), size, mask, 0);
+                bench::do_not_optimize(dest.front());
+            }
+        });
+        su.run("unmask_kernel", params, size, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                sl::websocket::apply_mask(src.data(), dest.data(), size, mask);
+                bench::do_not_optimize(dest.front());
+            }
+        });
+    }
+}
+
+// ASCII text, or mostly ASCII text with some 2- and 3-byte characters
+std::string make_text(size_t size, bool ascii) {
+    auto res = std::string();
+    while (res.length() < size) {
+        res += ascii ? "The quick brown fox jumps over the lazy dog, summer in Paris. " :
+                "The quick brown fox jumps over the lazy dog, \xc3\xa9t\xc3\xa9 \xe4\xb8\xad\xe6\x96\x87. ";
+    }
+    // do not cut a character in the middle
+    size_t len = size;
+    while (len > 0 && 0x80 == (static_cast<uint8_t>(res[len]) & 0xC0)) {
+        len -= 1;
+    }
+    res.resize(len);
+    return res;
+}
+
+std::string make_text_frame(const std::string& text) {
+    auto buf = std::array<char, 14>();
+    auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::text, text.length(), mask);
+    auto res = std::string(head.data(), head.size());
+    auto payload = std::string(text.length(), '\0');
+    sl::websocket::apply_mask(text.data(), std::addressof(payload.front()), text.length(), mask);
+    return res + payload;
+}
+
+void bench_text_decode(bench::suite& su) {
+    for (size_t size : {1 << 10, 1 << 16, 1 << 20}) {
+        for (bool ascii : {true, false}) {
+            auto data = make_text_frame(make_text(size, ascii));
+            auto dest = std::vector<char>(size);
+            auto params = bench::params_type{
+                {"size", sl::support::to_string(size)},
+                {"text", ascii ? "ascii" : "mixed"}
+            };
+            su.run("text_decode_three_pass", params, size, [&](uint64_t iters) {
+                auto validator = sl::websocket::utf8_validator();
+                for (uint64_t i = 0; i < iters; i++) {
+                    auto fr = sl::websocket::frame({data.data(), data.length()});
+                    auto payload = fr.payload();
+                    auto len = payload.size();
+                    std::memcpy(dest.data(), payload.data(), len);
+                    sl::websocket::apply_mask(dest.data(), dest.data(), len, fr.mask_value());
+                    validator.reset();
+                    bench::do_not_optimize(validator.update({dest.data(), len}));
+                }
+            });
+            su.run("text_decode_fused", params, size, [&](uint64_t iters) {
+                auto validator = sl::websocket::utf8_validator();
+                for (uint64_t i = 0; i < iters; i++) {
+                    auto fr = sl::websocket::frame({data.data(), data.length()});
+                    validator.reset();
+                    auto decoded = fr.decode_payload({dest.data(), dest.size()}, validator);
+                    bench::do_not_optimize(decoded.size());
+                }
+            });
+        }
+    }
+}
+
+void bench_parse(bench::suite& su) {
+    for (size_t size : sizes) {
+        for (bool masked : {false, true}) {
+            auto data = make_frame(sl::websocket::frame_type::binary, size, masked);
+            su.run("frame_parse", make_params(size, masked), 0, [&](uint64_t iters) {
+                for (uint64_t i = 0; i < iters; i++) {
+                    auto fr = sl::websocket::frame({data.data(), data.length()});
+                    bench::do_not_optimize(fr.is_complete());
+                }
+            });
+        }
+    }
+}
+
+void bench_payload_contiguous(bench::suite& su) {
+    for (size_t size : sizes) {
+        for (bool masked : {false, true}) {
+            auto data = make_frame(sl::websocket::frame_type::binary, size, masked);
+            auto dest = std::vector<char>(size + 1);
+            su.run("payload_unmasked_contiguous", make_params(size, masked), size, [&](uint64_t iters) {
+                for (uint64_t i = 0; i < iters; i++) {
+                    auto fr = sl::websocket::frame({data.data(), data.length()});
+                    auto src = fr.payload_unmasked();
+                    bench::do_not_optimize(drain(src, dest));
+                }
+            });
+        }
+    }
+}
+
+void bench_parser_fragmented(bench::suite& su) {
+    for (size_t size : sizes) {
+        for (bool masked : {false, true}) {
+            auto data = make_frame(sl::websocket::frame_type::binary, size, masked);
+            auto dest = std::vector<char>(size + 1);
+            su.run("frame_parser_fragmented", make_params(size, masked), size, [&](uint64_t iters) {
+                auto parser = sl::websocket::frame_parser();
+                for (uint64_t i = 0; i < iters; i++) {
+                    parser.reset();
+                    auto sink = sl::io::memory_sink({dest.data(), dest.size()});
+                    for (size_t pos = 0; pos < data.length();) {
+                        size_t len = std::min(chunk_size, data.length() - pos);
+                        pos += parser.feed({data.data() + pos, len}, sink);
+                    }
+                    bench::do_not_optimize(parser.is_complete());
+                }
+            });
+        }
+    }
+}
+
+void bench_assembler_fragmented(bench::suite& su) {
+    auto pool = sl::websocket::segment_pool();
+    for (size_t size : sizes) {
+        for (bool masked : {false, true}) {
+            auto data = make_message(size, masked);
+            auto ranges = std::vector<std::pair<size_t, size_t>>();
+            for (size_t pos = 0; pos < data.length();) {
+                auto fr = sl::websocket::frame({data.data() + pos, data.length() - pos});
+                if (!fr.is_complete()) {
+                    throw std::runtime_error("Invalid test message");
+                }
+                ranges.emplace_back(pos, static_cast<size_t>(fr.size()));
+                pos += static_cast<size_t>(fr.size());
+            }
+            su.run("message_assembler_fragmented", make_params(size, masked), size, [&](uint64_t iters) {
+                auto ma = sl::websocket::message_assembler(pool, size + 1, false);
+                for (uint64_t i = 0; i < iters; i++) {
+                    auto st = sl::websocket::message_status::incomplete;
+                    for (auto& ra : ranges) {
+                        auto fr = sl::websocket::frame({data.data() + ra.first, ra.second});
+                        st = ma.accept(fr);
+                    }
+                    bench::do_not_optimize(st);
+                    ma.clear();
+                }
+            });
+        }
+    }
+}
+
+// stream of small frames (chat-like traffic), one op is one frame
+void bench_small_stream(bench::suite& su) {
+    for (bool masked : {false, true}) {
+        auto stream = std::string();
+        size_t count = 0;
+        for (size_t size = 0; stream.length() < (1 << 16); size = (size + 7) % 126) {
+            stream += make_frame(sl::websocket::frame_type::text, size, masked);
+            count += 1;
+        }
+        auto params = bench::params_type{
+            {"masked", masked ? "true" : "false"},
+            {"avg_frame_size", sl::support::to_string(stream.length() / count)}
+        };
+        su.run("small_stream_frame", params, 0, [&](uint64_t iters) {
+            size_t pos = 0;
+            for (uint64_t i = 0; i < iters; i++) {
+                auto fr = sl::websocket::frame({stream.data() + pos, stream.length() - pos});
+                bench::do_not_optimize(fr);
+                pos += static_cast<size_t>(fr.size());
+                pos = pos < stream.length() ? pos : 0;
+            }
+        });
+        su.run("small_stream_header_decode", params, 0, [&](uint64_t iters) {
+            size_t pos = 0;
+            auto head = sl::websocket::frame_header();
+            for (uint64_t i = 0; i < iters; i++) {
+                sl::websocket::frame_header::decode({stream.data() + pos, stream.length() - pos}, head);
+                bench::do_not_optimize(head);
+                pos += static_cast<size_t>(head.size());
+                pos = pos < stream.length() ? pos : 0;
+            }
+        });
+    }
+}
+
+void bench_make_header(bench::suite& su) {
+    for (size_t size : sizes) {
+        su.run("make_header_server", make_params(size, false), 0, [&](uint64_t iters) {
+            auto buf = std::array<char, 10>();
+            for (uint64_t i = 0; i < iters; i++) {
+                auto head = sl::websocket::frame_encoder<sl::websocket::server_role>::make_header(buf,
+                        sl::websocket::frame_type::binary, size + (i & 1));
+                bench::do_not_optimize(head);
+            }
+        });
+        su.run("make_header_client", make_params(size, true), 0, [&](uint64_t iters) {
+            auto buf = std::array<char, 14>();
+            for (uint64_t i = 0; i < iters; i++) {
+                auto head = sl::websocket::frame_encoder<sl::websocket::client_role>::make_header(buf,
+                        sl::websocket::frame_type::binary, size + (i & 1), mask);
+                bench::do_not_optimize(head);
+            }
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("frame", argc, argv);
+        bench_unmask(su);
+        bench_parse(su);
+        bench_payload_contiguous(su);
+        bench_parser_fragmented(su);
+        bench_assembler_fragmented(su);
+        bench_small_stream(su);
+        bench_text_decode(su);
+        bench_make_header(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
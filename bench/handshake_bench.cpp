@@ -0,0 +1,84 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   handshake_bench.cpp
+ */
+
+#include "staticlib/websocket/handshake.hpp"
+#include "staticlib/websocket/upgrade_request.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const std::string key = "dGhlIHNhbXBsZSBub25jZQ==";
+
+const std::string request = std::string() +
+        "GET /chat HTTP/1.1\r\n" +
+        "Host: server.example.com\r\n" +
+        "Upgrade: websocket\r\n" +
+        "Connection: Upgrade\r\n" +
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n" +
+        "Origin: http://example.com\r\n" +
+        "Sec-WebSocket-Protocol: chat, superchat\r\n" +
+        "Sec-WebSocket-Version: 13\r\n" +
+        "\r\n";
+
+void bench_response(bench::suite& su) {
+    su.run("make_response_headers", {}, 0, [&](uint64_t iters) {
+        for (uint64_t i = 0; i < iters; i++) {
+            auto headers = sl::websocket::handshake::make_response_headers(key);
+            bench::do_not_optimize(headers.back().second.front());
+        }
+    });
+    su.run("write_response", {}, 0, [&](uint64_t iters) {
+        auto buf = std::array<char, 256>();
+        for (uint64_t i = 0; i < iters; i++) {
+            auto len = sl::websocket::handshake::write_response({key.data(), key.length()},
+                    {buf.data(), buf.size()});
+            bench::do_not_optimize(len);
+        }
+    });
+}
+
+void bench_request(bench::suite& su) {
+    su.run("parse_request", {}, request.length(), [&](uint64_t iters) {
+        for (uint64_t i = 0; i < iters; i++) {
+            auto req = sl::websocket::handshake::upgrade_request();
+            auto st = sl::websocket::handshake::parse_request({request.data(), request.length()}, req);
+            bench::do_not_optimize(st);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("handshake", argc, argv);
+        bench_response(su);
+        bench_request(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
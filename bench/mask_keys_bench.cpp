@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   mask_keys_bench.cpp
+ */
+
+#include "staticlib/websocket/mask_keys.hpp"
+
+#include <array>
+#include <iostream>
+#include <memory>
+
+#include <openssl/rand.h>
+
+#include "staticlib/websocket/frame_encoder.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+void bench_keys(bench::suite& su) {
+    // baseline: one RAND_bytes call per frame
+    su.run("rand_bytes_per_key", {}, 0, [&](uint64_t iters) {
+        for (uint64_t i = 0; i < iters; i++) {
+            uint32_t key = 0;
+            while (0 == key) {
+                RAND_bytes(reinterpret_cast<unsigned char*>(std::addressof(key)), 4);
+            }
+            bench::do_not_optimize(key);
+        }
+    });
+    su.run("generator_next", {}, 0, [&](uint64_t iters) {
+        auto& gen = sl::websocket::thread_mask_keys();
+        for (uint64_t i = 0; i < iters; i++) {
+            auto key = gen.next();
+            bench::do_not_optimize(key);
+        }
+    });
+    su.run("client_make_header", {}, 0, [&](uint64_t iters) {
+        auto& gen = sl::websocket::thread_mask_keys();
+        auto buf = std::array<char, 14>();
+        for (uint64_t i = 0; i < iters; i++) {
+            auto head = sl::websocket::frame_encoder<sl::websocket::client_role>::make_header(
+                    buf, sl::websocket::frame_type::binary, 16, gen.next());
+            bench::do_not_optimize(head);
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("mask_keys", argc, argv);
+        bench_keys(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
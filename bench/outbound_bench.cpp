@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   outbound_bench.cpp
+ */
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_WINDOWS
+
+#include "staticlib/websocket/outbound_queue.hpp"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const size_t batch_frames = 64;
+
+// chatty workload: small text messages written to /dev/null,
+// one write per message vs coalesced writev batches
+void bench_small_messages(bench::suite& su, int fd) {
+    for (size_t size : {16, 125}) {
+        auto payload = std::string(size, 'a');
+        auto params = bench::params_type{{"size", sl::support::to_string(size)}};
+        su.run("write_per_message", params, size, [&](uint64_t iters) {
+            auto buf = std::array<char, 10>();
+            for (uint64_t i = 0; i < iters; i++) {
+                auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::text, size);
+                auto iov = std::array<struct iovec, 2>();
+                iov[0].iov_base = const_cast<char*>(head.data());
+                iov[0].iov_len = head.size();
+                iov[1].iov_base = const_cast<char*>(payload.data());
+                iov[1].iov_len = payload.size();
+                auto written = ::writev(fd, iov.data(), 2);
+                bench::do_not_optimize(written);
+            }
+        });
+        su.run("write_coalesced", params, size, [&](uint64_t iters) {
+            sl::websocket::outbound_queue<batch_frames> queue;
+            sl::websocket::vectored_encoder<batch_frames> batch;
+            auto iov = std::array<struct iovec, batch_frames * 2>();
+            uint64_t sent = 0;
+            while (sent < iters) {
+                for (size_t i = 0; i < batch_frames && sent + queue.size() < iters; i++) {
+                    queue.push(sl::websocket::frame_type::text, sl::io::make_span(payload.data(), size));
+                }
+                sent += queue.fill(batch);
+                auto count = batch.to_iovec(iov.data(), iov.size());
+                auto written = ::writev(fd, iov.data(), static_cast<int>(count));
+                batch.consume(static_cast<size_t>(written));
+            }
+            bench::do_not_optimize(sent);
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto fd = ::open("/dev/null", O_WRONLY);
+        if (-1 == fd) {
+            throw sl::support::exception(TRACEMSG("Cannot open '/dev/null'"));
+        }
+        auto su = bench::suite("outbound", argc, argv);
+        bench_small_messages(su, fd);
+        ::close(fd);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
+
+#else // STATICLIB_WINDOWS
+
+int main() {
+    return 0;
+}
+
+#endif // !STATICLIB_WINDOWS
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   ring_buffer_bench.cpp
+ */
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_WINDOWS
+
+#include "staticlib/websocket/ring_buffer.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_range.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const size_t capacity = 1 << 20;
+const size_t chunk_size = 16384;
+
+std::string make_stream(size_t frame_size) {
+    auto res = std::string();
+    auto payload = std::string(frame_size, 'a');
+    auto buf = std::array<char, 10>();
+    while (res.length() < capacity * 4) {
+        auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::binary, frame_size);
+        res.append(head.data(), head.size());
+        res.append(payload);
+    }
+    return res;
+}
+
+// parses all complete frames, returns the number of bytes consumed
+size_t parse(sl::io::span<const char> data) {
+    auto range = sl::websocket::frame_range(data);
+    for (auto& rec : range) {
+        bench::do_not_optimize(rec.payload().data());
+    }
+    return range.consumed();
+}
+
+// received chunks are copied from the prepared stream, as if they were read with `recv`
+void bench_receive(bench::suite& su) {
+    for (size_t size : {4096, 65536, 262144}) {
+        auto stream = make_stream(size);
+        auto params = bench::params_type{{"frame_size", sl::support::to_string(size)}};
+        su.run("linear_memmove", params, chunk_size, [&](uint64_t iters) {
+            auto buf = std::vector<char>(capacity);
+            size_t begin = 0;
+            size_t end = 0;
+            size_t pos = 0;
+            for (uint64_t i = 0; i < iters; i++) {
+                if (capacity - end < chunk_size) {
+                    std::memmove(buf.data(), buf.data() + begin, end - begin);
+                    end -= begin;
+                    begin = 0;
+                }
+                size_t len = std::min(chunk_size, stream.length() - pos);
+                std::memcpy(buf.data() + end, stream.data() + pos, len);
+                end += len;
+                pos = len < chunk_size ? 0 : pos + len;
+                begin += parse({buf.data() + begin, end - begin});
+                if (begin == end || 0 == pos) {
+                    begin = 0;
+                    end = 0;
+                }
+            }
+        });
+        su.run("mirrored_ring", params, chunk_size, [&](uint64_t iters) {
+            auto rb = sl::websocket::ring_buffer(capacity);
+            size_t pos = 0;
+            for (uint64_t i = 0; i < iters; i++) {
+                size_t len = std::min(chunk_size, stream.length() - pos);
+                auto space = rb.reserve(len);
+                std::memcpy(space.data(), stream.data() + pos, len);
+                rb.commit(len);
+                pos = len < chunk_size ? 0 : pos + len;
+                rb.consume(parse(rb.data()));
+                if (0 == pos) {
+                    rb.clear();
+                }
+            }
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("ring_buffer", argc, argv);
+        bench_receive(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
+
+#else // STATICLIB_WINDOWS
+
+int main() {
+    return 0;
+}
+
+#endif // !STATICLIB_WINDOWS
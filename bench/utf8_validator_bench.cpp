@@ -0,0 +1,106 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   utf8_validator_bench.cpp
+ */
+
+#include "staticlib/websocket/utf8_validator.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "bench.hpp"
+
+namespace { // anonymous
+
+const std::vector<size_t> sizes = {1 << 10, 1 << 16, 1 << 20};
+
+std::string make_text(const std::string& corpus, size_t size) {
+    auto res = std::string();
+    while (res.length() < size) {
+        res += corpus;
+    }
+    // do not cut a code point in the middle
+    size_t len = size;
+    while (len > 0 && 0x80 == (static_cast<uint8_t>(res[len]) & 0xC0)) {
+        len -= 1;
+    }
+    res.resize(len);
+    return res;
+}
+
+// byte-wise DFA without ASCII skipping and direct sequence checks
+bool validate_dfa(const std::string& text) {
+    auto classes = sl::websocket::detail_utf8::byte_classes();
+    auto trans = sl::websocket::detail_utf8::transitions();
+    auto st = sl::websocket::detail_utf8::state_accept;
+    for (char ch : text) {
+        st = trans[st + classes[static_cast<uint8_t>(ch)]];
+    }
+    return sl::websocket::detail_utf8::state_accept == st;
+}
+
+void bench_validate(bench::suite& su) {
+    auto corpora = std::vector<std::pair<std::string, std::string>>{
+        {"ascii", "The quick brown fox jumps over the lazy dog. "},
+        // Latin-1 supplement letters in French text
+        {"mixed", sl::io::string_from_hex("4c6520632ec3b375722061206c6573207261697320717565206c6120726169736f6e206e6520636f6e6e61c3ae7420706f696e742e20c3a974c3a920")},
+        // CJK ideographs with some ASCII punctuation
+        {"cjk", sl::io::string_from_hex("e6bca2e5ad97e381afe697a5e69cace8aa9ee381aee69687e5ad97e381a7e38199e3808220")}
+    };
+    for (auto& co : corpora) {
+        for (size_t size : sizes) {
+            auto text = make_text(co.second, size);
+            if (!validate_dfa(text)) {
+                throw std::runtime_error("Invalid test corpus: [" + co.first + "]");
+            }
+            auto params = bench::params_type{
+                {"text", co.first},
+                {"size", sl::support::to_string(size)}
+            };
+            su.run("utf8_validator_update", params, text.length(), [&](uint64_t iters) {
+                for (uint64_t i = 0; i < iters; i++) {
+                    auto val = sl::websocket::utf8_validator();
+                    bench::do_not_optimize(val.update(text) && val.is_complete());
+                }
+            });
+            su.run("utf8_dfa_bytewise", params, text.length(), [&](uint64_t iters) {
+                for (uint64_t i = 0; i < iters; i++) {
+                    bench::do_not_optimize(validate_dfa(text));
+                }
+            });
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto su = bench::suite("utf8_validator", argc, argv);
+        bench_validate(su);
+        return su.finish();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
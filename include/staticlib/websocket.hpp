@@ -26,10 +26,31 @@
 
 #include "staticlib/config.hpp"
 
+#include "staticlib/websocket/broadcast_hub.hpp"
+#include "staticlib/websocket/buffer_pool.hpp"
+#include "staticlib/websocket/control_frames.hpp"
+#include "staticlib/websocket/deflate_params.hpp"
+#include "staticlib/websocket/encoded_frame.hpp"
 #include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_encoder.hpp"
+#include "staticlib/websocket/frame_header.hpp"
+#include "staticlib/websocket/frame_parser.hpp"
+#include "staticlib/websocket/frame_range.hpp"
 #include "staticlib/websocket/frame_type.hpp"
 #include "staticlib/websocket/handshake.hpp"
+#include "staticlib/websocket/masked_payload_sink.hpp"
 #include "staticlib/websocket/masked_payload_source.hpp"
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/message_assembler.hpp"
+#include "staticlib/websocket/outbound_queue.hpp"
+#include "staticlib/websocket/role.hpp"
+#include "staticlib/websocket/segment_pool.hpp"
+#include "staticlib/websocket/stats.hpp"
+#include "staticlib/websocket/upgrade_request.hpp"
+#include "staticlib/websocket/upgrade_response.hpp"
+#include "staticlib/websocket/utf8_validator.hpp"
+#include "staticlib/websocket/vectored_encoder.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
 
 
 #endif /* STATICLIB_WEBSOCKET_HPP */
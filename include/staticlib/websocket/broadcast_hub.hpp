@@ -0,0 +1,340 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   broadcast_hub.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_BROADCAST_HUB_HPP
+#define STATICLIB_WEBSOCKET_BROADCAST_HUB_HPP
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/encoded_frame.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_broadcast {
+
+/**
+ * Subscribers of a single topic, index allows to remove
+ * a subscriber without scanning the list
+ */
+template<typename Subscriber>
+struct topic_subscribers {
+    std::vector<Subscriber> list;
+    std::unordered_map<Subscriber, size_t> index;
+};
+
+/**
+ * Change of the topic subscribers list, that was requested
+ * during `publish` and is applied after it
+ */
+template<typename Subscriber>
+struct deferred_change {
+    std::string topic;
+    Subscriber subscriber;
+    bool add;
+
+    deferred_change(const std::string& topic, const Subscriber& subscriber, bool add) :
+    topic(topic),
+    subscriber(subscriber),
+    add(add) { }
+};
+
+} // namespace
+
+template<typename Subscriber>
+class broadcast_hub;
+
+namespace detail_broadcast {
+
+/**
+ * Applies deferred changes when the outermost `publish` returns
+ * (or throws)
+ */
+template<typename Subscriber>
+class publish_guard {
+    broadcast_hub<Subscriber>& hub;
+
+public:
+    explicit publish_guard(broadcast_hub<Subscriber>& hub) :
+    hub(hub) {
+        hub.publishing += 1;
+    }
+
+    publish_guard(const publish_guard&) = delete;
+
+    publish_guard& operator=(const publish_guard&) = delete;
+
+    ~publish_guard() STATICLIB_NOEXCEPT {
+        hub.publishing -= 1;
+        if (0 == hub.publishing) {
+            hub.apply_deferred();
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * Topic-based index of subscribers, that delivers the same encoded
+ * frame to all the subscribers of the topic. Message is encoded once
+ * into `encoded_frame` and only the reference to it is passed
+ * to each subscriber.
+ *
+ * Hub is not thread-safe.
+ *
+ * @tparam Subscriber subscriber identifier (connection pointer or ID),
+ *         must be equality-comparable and hashable with `std::hash`
+ */
+template<typename Subscriber>
+class broadcast_hub {
+    friend class detail_broadcast::publish_guard<Subscriber>;
+
+    std::unordered_map<std::string, detail_broadcast::topic_subscribers<Subscriber>> topics;
+    std::unordered_map<Subscriber, std::vector<std::string>> subscriptions;
+    // topic lists are not changed while publish iterates over them
+    std::vector<detail_broadcast::deferred_change<Subscriber>> deferred;
+    size_t publishing = 0;
+
+public:
+    /**
+     * Constructor
+     */
+    broadcast_hub() { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    broadcast_hub(const broadcast_hub&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    broadcast_hub& operator=(const broadcast_hub&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    broadcast_hub(broadcast_hub&& other) :
+    topics(std::move(other.topics)),
+    subscriptions(std::move(other.subscriptions)),
+    deferred(std::move(other.deferred)) { }
+
+    /**
+     * Subscribes to the topic
+     *
+     * @param topic topic name
+     * @param subscriber subscriber
+     * @return `false` if subscriber is already subscribed to this topic
+     */
+    bool subscribe(const std::string& topic, const Subscriber& subscriber) {
+        auto& names = subscriptions[subscriber];
+        if (names.end() != std::find(names.begin(), names.end(), topic)) {
+            return false;
+        }
+        names.push_back(topic);
+        if (publishing > 0) {
+            deferred.emplace_back(topic, subscriber, true);
+        } else {
+            add_to_topic(topic, subscriber);
+        }
+        return true;
+    }
+
+    /**
+     * Unsubscribes from the topic
+     *
+     * @param topic topic name
+     * @param subscriber subscriber
+     * @return `false` if subscriber was not subscribed to this topic
+     */
+    bool unsubscribe(const std::string& topic, const Subscriber& subscriber) {
+        auto it = subscriptions.find(subscriber);
+        if (subscriptions.end() == it) {
+            return false;
+        }
+        auto& names = it->second;
+        auto name_it = std::find(names.begin(), names.end(), topic);
+        if (names.end() == name_it) {
+            return false;
+        }
+        std::swap(*name_it, names.back());
+        names.pop_back();
+        if (names.empty()) {
+            subscriptions.erase(it);
+        }
+        change_removed(topic, subscriber);
+        return true;
+    }
+
+    /**
+     * Unsubscribes from all topics, should be called when connection is closed
+     *
+     * @param subscriber subscriber
+     * @return number of topics subscriber was removed from
+     */
+    size_t unsubscribe_all(const Subscriber& subscriber) {
+        auto it = subscriptions.find(subscriber);
+        if (subscriptions.end() == it) {
+            return 0;
+        }
+        auto names = std::move(it->second);
+        subscriptions.erase(it);
+        for (auto& topic : names) {
+            change_removed(topic, subscriber);
+        }
+        return names.size();
+    }
+
+    /**
+     * Passes the shared encoded frame to all subscribers of the topic
+     *
+     * @param topic topic name
+     * @param frame encoded frame
+     * @param deliver functor called as `deliver(subscriber, frame)` for each subscriber,
+     *        usually puts the frame into the subscriber's send queue; it may subscribe
+     *        and unsubscribe, frame is passed to the subscribers of the topic
+     *        as they were when `publish` was called, subscribers lists are updated
+     *        after the outermost `publish` returns
+     * @return number of subscribers the frame was passed to
+     */
+    template<typename Deliver>
+    size_t publish(const std::string& topic, const std::shared_ptr<const encoded_frame>& frame,
+            Deliver deliver) {
+        auto it = topics.find(topic);
+        if (topics.end() == it) {
+            return 0;
+        }
+        detail_broadcast::publish_guard<Subscriber> guard(*this);
+        auto& subs = it->second.list;
+        for (auto& sub : subs) {
+            deliver(sub, frame);
+        }
+        return subs.size();
+    }
+
+    /**
+     * Encodes the message once and passes it to all subscribers of the topic,
+     * message is not encoded if topic has no subscribers
+     *
+     * @param topic topic name
+     * @param fr_type frame type
+     * @param payload message payload
+     * @param deliver functor called as `deliver(subscriber, frame)` for each subscriber
+     * @return number of subscribers the frame was passed to
+     */
+    template<typename Deliver>
+    size_t publish(const std::string& topic, frame_type fr_type, sl::io::span<const char> payload,
+            Deliver deliver) {
+        if (0 == subscribers_count(topic)) {
+            return 0;
+        }
+        return publish(topic, make_encoded_frame(fr_type, payload), deliver);
+    }
+
+    /**
+     * Number of subscribers of the topic
+     *
+     * @param topic topic name
+     * @return number of subscribers
+     */
+    size_t subscribers_count(const std::string& topic) const {
+        auto it = topics.find(topic);
+        return topics.end() != it ? it->second.list.size() : 0;
+    }
+
+    /**
+     * Number of topics that have subscribers
+     *
+     * @return number of topics
+     */
+    size_t topics_count() const {
+        return topics.size();
+    }
+
+private:
+    void change_removed(const std::string& topic, const Subscriber& subscriber) {
+        if (publishing > 0) {
+            deferred.emplace_back(topic, subscriber, false);
+        } else {
+            remove_from_topic(topic, subscriber);
+        }
+    }
+
+    void apply_deferred() {
+        // publish is not called from here, list cannot grow while iterating
+        for (auto& ch : deferred) {
+            if (ch.add) {
+                add_to_topic(ch.topic, ch.subscriber);
+            } else {
+                remove_from_topic(ch.topic, ch.subscriber);
+            }
+        }
+        deferred.clear();
+    }
+
+    void add_to_topic(const std::string& topic, const Subscriber& subscriber) {
+        auto& subs = topics[topic];
+        subs.index.emplace(subscriber, subs.list.size());
+        subs.list.push_back(subscriber);
+    }
+
+    void remove_from_topic(const std::string& topic, const Subscriber& subscriber) {
+        auto it = topics.find(topic);
+        if (topics.end() == it) {
+            return;
+        }
+        auto& subs = it->second;
+        auto idx_it = subs.index.find(subscriber);
+        if (subs.index.end() != idx_it) {
+            size_t idx = idx_it->second;
+            subs.index.erase(idx_it);
+            if (idx != subs.list.size() - 1) {
+                subs.list[idx] = std::move(subs.list.back());
+                subs.index[subs.list[idx]] = idx;
+            }
+            subs.list.pop_back();
+        }
+        if (subs.list.empty()) {
+            topics.erase(it);
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_BROADCAST_HUB_HPP */
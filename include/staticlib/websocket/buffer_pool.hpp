@@ -0,0 +1,709 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   buffer_pool.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_BUFFER_POOL_HPP
+#define STATICLIB_WEBSOCKET_BUFFER_POOL_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_LINUX
+#include <sys/mman.h>
+#endif // STATICLIB_LINUX
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Buffer size classes, aligned with the frame payload length encodings
+ */
+enum class buffer_class {
+    /**
+     * Frames with 7-bit payload length (up to 125 bytes) and any header
+     */
+    small,
+    /**
+     * Frames with 16-bit payload length (up to 64K) and any header
+     */
+    medium,
+    /**
+     * Frames with 64-bit payload length up to the configured large buffer size
+     */
+    large,
+    /**
+     * Requests above the large buffer size, such buffers are
+     * allocated from the heap and are not pooled
+     */
+    oversize
+};
+
+/**
+ * Configuration of the buffer pool
+ */
+struct buffer_pool_config {
+    /**
+     * Size of the buffers of `large` class
+     */
+    size_t large_buffer_size = 1 << 20;
+    /**
+     * Size of the memory block (slab), that is split into the
+     * buffers of the same class, slab holds at least one buffer
+     */
+    size_t slab_size = 1 << 21;
+    /**
+     * Whether slabs need to be backed by huge pages, explicit huge pages
+     * are tried first with fallback to transparent huge pages,
+     * supported only on Linux
+     */
+    bool huge_pages = false;
+};
+
+/**
+ * Occupancy of a single size class
+ */
+struct buffer_class_stats {
+    /**
+     * Size of each buffer in bytes
+     */
+    size_t buffer_size = 0;
+    /**
+     * Number of allocated slabs
+     */
+    size_t slabs = 0;
+    /**
+     * Total number of buffers in all slabs
+     */
+    size_t capacity = 0;
+    /**
+     * Free buffers in the shared free list
+     */
+    size_t free = 0;
+    /**
+     * Free buffers held by thread caches
+     */
+    size_t cached = 0;
+    /**
+     * Buffers currently in use
+     */
+    size_t in_use = 0;
+};
+
+class buffer_pool;
+class buffer_cache;
+
+namespace detail_buffer {
+
+const size_t pooled_classes = 3;
+
+// 125 bytes payload with 14 bytes header, rounded up
+const size_t small_buffer_size = 256;
+
+// 64K payload with 14 bytes header, rounded up
+const size_t medium_buffer_size = (1 << 16) + 64;
+
+/**
+ * Memory block, that is split into the buffers of the same size
+ */
+struct slab {
+    char* data;
+    size_t len;
+    bool mapped;
+};
+
+inline slab allocate_slab(size_t len, bool huge_pages) {
+#ifdef STATICLIB_LINUX
+    if (huge_pages) {
+        void* ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        // explicit huge pages are available only when reserved by admin
+        const size_t huge_page = 1 << 21;
+        size_t huge_len = ((len + huge_page - 1) / huge_page) * huge_page;
+        ptr = ::mmap(nullptr, huge_len, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (MAP_FAILED != ptr) {
+            return slab{static_cast<char*>(ptr), huge_len, true};
+        }
+#endif // MAP_HUGETLB
+        ptr = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == ptr) {
+            throw websocket_exception(TRACEMSG("Slab allocation error, size: [" + sl::support::to_string(len) + "]"));
+        }
+#ifdef MADV_HUGEPAGE
+        // hint only, result is ignored
+        ::madvise(ptr, len, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+        return slab{static_cast<char*>(ptr), len, true};
+    }
+#else // !STATICLIB_LINUX
+    (void) huge_pages;
+#endif // STATICLIB_LINUX
+    return slab{new char[len], len, false};
+}
+
+inline void free_slab(slab& sb) STATICLIB_NOEXCEPT {
+#ifdef STATICLIB_LINUX
+    if (sb.mapped) {
+        ::munmap(sb.data, sb.len);
+        return;
+    }
+#endif // STATICLIB_LINUX
+    delete[] sb.data;
+}
+
+/**
+ * Free buffers counts of a single thread cache, only the owning thread
+ * writes them, pool reads them to report stats
+ */
+struct cache_counts {
+    std::array<std::atomic<size_t>, pooled_classes> values;
+
+    cache_counts() {
+        for (auto& va : values) {
+            va.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void set(size_t cls, size_t val) {
+        values[cls].store(val, std::memory_order_relaxed);
+    }
+};
+
+} // namespace
+
+/**
+ * Buffer taken from the `buffer_pool` or from the `buffer_cache`,
+ * buffer is returned back automatically on destruction.
+ * Is movable, but not copyable.
+ */
+class pooled_buffer {
+    friend class buffer_pool;
+    friend class buffer_cache;
+
+    buffer_pool* pool = nullptr;
+    buffer_cache* cache = nullptr;
+    char* ptr = nullptr;
+    size_t len = 0;
+    size_t cap = 0;
+    buffer_class cls = buffer_class::small;
+
+    pooled_buffer(buffer_pool* owner_pool, buffer_cache* owner_cache, char* data,
+            size_t size, size_t capacity, buffer_class size_class) :
+    pool(owner_pool),
+    cache(owner_cache),
+    ptr(data),
+    len(size),
+    cap(capacity),
+    cls(size_class) { }
+
+public:
+    /**
+     * Constructor for an empty buffer
+     */
+    pooled_buffer() { }
+
+    /**
+     * Destructor, returns buffer back
+     */
+    ~pooled_buffer() STATICLIB_NOEXCEPT {
+        reset();
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    pooled_buffer(const pooled_buffer&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    pooled_buffer& operator=(const pooled_buffer&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    pooled_buffer(pooled_buffer&& other) STATICLIB_NOEXCEPT :
+    pool(other.pool),
+    cache(other.cache),
+    ptr(other.ptr),
+    len(other.len),
+    cap(other.cap),
+    cls(other.cls) {
+        other.ptr = nullptr;
+        other.len = 0;
+        other.cap = 0;
+    }
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    pooled_buffer& operator=(pooled_buffer&& other) STATICLIB_NOEXCEPT {
+        if (this != &other) {
+            reset();
+            pool = other.pool;
+            cache = other.cache;
+            ptr = other.ptr;
+            len = other.len;
+            cap = other.cap;
+            cls = other.cls;
+            other.ptr = nullptr;
+            other.len = 0;
+            other.cap = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * Buffer bytes
+     *
+     * @return pointer to the first byte, null for empty buffer
+     */
+    char* data() {
+        return ptr;
+    }
+
+    /**
+     * Buffer bytes
+     *
+     * @return pointer to the first byte, null for empty buffer
+     */
+    const char* data() const {
+        return ptr;
+    }
+
+    /**
+     * Requested size of the buffer
+     *
+     * @return requested size
+     */
+    size_t size() const {
+        return len;
+    }
+
+    /**
+     * Actual size of the buffer (size of the buffers in its size class)
+     *
+     * @return buffer capacity
+     */
+    size_t capacity() const {
+        return cap;
+    }
+
+    /**
+     * Size class of the buffer
+     *
+     * @return size class
+     */
+    buffer_class size_class() const {
+        return cls;
+    }
+
+    /**
+     * Returns buffer back to its pool (or thread cache),
+     * buffer becomes empty
+     */
+    inline void reset() STATICLIB_NOEXCEPT;
+};
+
+/**
+ * Thread-safe pool of buffers of fixed size classes. Buffers are carved
+ * from large slabs, so the heap is not fragmented by many short-lived
+ * buffers of different sizes; slabs are kept until the pool is destroyed.
+ * Buffers can be taken from the pool directly (one mutex lock per operation),
+ * or through the per-thread `buffer_cache`, that moves buffers from/to
+ * the pool in batches.
+ *
+ * Pool must outlive all the caches and all the buffers taken from it.
+ */
+class buffer_pool {
+    friend class buffer_cache;
+    friend class pooled_buffer;
+
+    /**
+     * Slabs and free buffers of the single size class
+     */
+    struct class_state {
+        size_t buffer_size = 0;
+        size_t per_slab = 0;
+        std::vector<detail_buffer::slab> slabs;
+        std::vector<char*> free_list;
+    };
+
+    bool huge_pages;
+    mutable std::mutex mtx;
+    std::array<class_state, detail_buffer::pooled_classes> classes;
+    std::vector<detail_buffer::cache_counts*> caches;
+    std::atomic<size_t> oversize_count;
+
+public:
+    /**
+     * Constructor, no memory is allocated until the first buffer is requested
+     *
+     * @param config pool configuration
+     * @throws websocket_exception on invalid configuration
+     */
+    buffer_pool(const buffer_pool_config& config = buffer_pool_config()) :
+    huge_pages(config.huge_pages),
+    oversize_count(0) {
+        if (config.large_buffer_size <= detail_buffer::medium_buffer_size) {
+            throw websocket_exception(TRACEMSG("Invalid large buffer size specified,"
+                    " size: [" + sl::support::to_string(config.large_buffer_size) + "]," +
+                    " min: [" + sl::support::to_string(detail_buffer::medium_buffer_size + 1) + "]"));
+        }
+        auto sizes = std::array<size_t, detail_buffer::pooled_classes>{{
+            detail_buffer::small_buffer_size,
+            detail_buffer::medium_buffer_size,
+            config.large_buffer_size
+        }};
+        for (size_t i = 0; i < classes.size(); i++) {
+            classes[i].buffer_size = sizes[i];
+            classes[i].per_slab = std::max(config.slab_size / sizes[i], static_cast<size_t>(1));
+        }
+    }
+
+    /**
+     * Destructor, frees all slabs
+     */
+    ~buffer_pool() STATICLIB_NOEXCEPT {
+        for (auto& cs : classes) {
+            for (auto& sb : cs.slabs) {
+                detail_buffer::free_slab(sb);
+            }
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    buffer_pool(const buffer_pool&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    buffer_pool& operator=(const buffer_pool&) = delete;
+
+    /**
+     * Size class for the specified number of bytes
+     *
+     * @param size number of bytes
+     * @return size class
+     */
+    buffer_class classify(size_t size) const {
+        for (size_t i = 0; i < classes.size(); i++) {
+            if (size <= classes[i].buffer_size) {
+                return static_cast<buffer_class>(i);
+            }
+        }
+        return buffer_class::oversize;
+    }
+
+    /**
+     * Size of the buffers of the specified class
+     *
+     * @param cls pooled size class
+     * @return buffer size in bytes
+     */
+    size_t buffer_size(buffer_class cls) const {
+        return classes[index(cls)].buffer_size;
+    }
+
+    /**
+     * Takes a buffer of the smallest class, that can hold
+     * the specified number of bytes, can be called from any thread
+     *
+     * @param size number of bytes
+     * @return buffer, it is returned back to the pool on destruction
+     */
+    pooled_buffer acquire(size_t size) {
+        auto cls = classify(size);
+        if (buffer_class::oversize == cls) {
+            oversize_count.fetch_add(1, std::memory_order_relaxed);
+            return pooled_buffer(this, nullptr, new char[size], size, size, cls);
+        }
+        size_t idx = index(cls);
+        char* ptr = nullptr;
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            take(idx, &ptr, 1);
+        }
+        return pooled_buffer(this, nullptr, ptr, size, classes[idx].buffer_size, cls);
+    }
+
+    /**
+     * Occupancy of the specified size class, caches are updated
+     * concurrently, so the values are approximate
+     *
+     * @param cls pooled size class
+     * @return class stats
+     */
+    buffer_class_stats stats(buffer_class cls) const {
+        size_t idx = index(cls);
+        auto res = buffer_class_stats();
+        std::lock_guard<std::mutex> guard{mtx};
+        auto& cs = classes[idx];
+        res.buffer_size = cs.buffer_size;
+        res.slabs = cs.slabs.size();
+        res.capacity = cs.slabs.size() * cs.per_slab;
+        res.free = cs.free_list.size();
+        for (auto cc : caches) {
+            res.cached += cc->values[idx].load(std::memory_order_relaxed);
+        }
+        res.in_use = res.capacity - res.free - std::min(res.cached, res.capacity - res.free);
+        return res;
+    }
+
+    /**
+     * Number of oversize (not pooled) buffers currently in use
+     *
+     * @return number of oversize buffers
+     */
+    size_t oversize_in_use() const {
+        return oversize_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Total size of all allocated slabs
+     *
+     * @return number of bytes reserved by the pool
+     */
+    size_t reserved_bytes() const {
+        std::lock_guard<std::mutex> guard{mtx};
+        size_t res = 0;
+        for (auto& cs : classes) {
+            for (auto& sb : cs.slabs) {
+                res += sb.len;
+            }
+        }
+        return res;
+    }
+
+private:
+    static size_t index(buffer_class cls) {
+        auto idx = static_cast<size_t>(cls);
+        if (idx >= detail_buffer::pooled_classes) {
+            throw websocket_exception(TRACEMSG("Invalid pooled size class specified,"
+                    " class: [" + sl::support::to_string(idx) + "]"));
+        }
+        return idx;
+    }
+
+    // must be called under lock
+    void take(size_t idx, char** dest, size_t count) {
+        auto& cs = classes[idx];
+        while (cs.free_list.size() < count) {
+            auto sb = detail_buffer::allocate_slab(cs.per_slab * cs.buffer_size, huge_pages);
+            cs.slabs.push_back(sb);
+            // free list can hold all the buffers, so returning
+            // buffers back never reallocates it
+            cs.free_list.reserve(cs.slabs.size() * cs.per_slab);
+            // reversed, so buffers are taken in address order
+            for (size_t i = cs.per_slab; i > 0; i--) {
+                cs.free_list.push_back(sb.data + (i - 1) * cs.buffer_size);
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = cs.free_list.back();
+            cs.free_list.pop_back();
+        }
+    }
+
+    void give(size_t idx, char* const* src, size_t count) {
+        std::lock_guard<std::mutex> guard{mtx};
+        auto& cs = classes[idx];
+        cs.free_list.insert(cs.free_list.end(), src, src + count);
+    }
+
+    void release(pooled_buffer& buf) STATICLIB_NOEXCEPT {
+        if (buffer_class::oversize == buf.cls) {
+            delete[] buf.ptr;
+            oversize_count.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+            give(static_cast<size_t>(buf.cls), &buf.ptr, 1);
+        }
+    }
+};
+
+/**
+ * Per-thread front of the `buffer_pool`, is NOT thread-safe.
+ * Keeps a limited number of free buffers of each class, buffers
+ * are moved from/to the pool in batches, so most of the acquire/release
+ * calls do not touch the pool mutex.
+ *
+ * Buffers taken from the cache must be released on the cache thread
+ * before the cache is destroyed (buffers that can be released on other threads,
+ * like shared `encoded_frame` ones, should be taken from the pool directly).
+ */
+class buffer_cache {
+    friend class pooled_buffer;
+
+    buffer_pool& pool;
+    size_t max_cached;
+    size_t batch;
+    std::array<std::vector<char*>, detail_buffer::pooled_classes> lists;
+    detail_buffer::cache_counts counts;
+
+public:
+    /**
+     * Constructor, cache is registered in pool to report stats
+     *
+     * @param buffers_pool pool, must outlive this cache
+     * @param max_cached_per_class max number of free buffers of each class
+     *        kept in this cache
+     */
+    buffer_cache(buffer_pool& buffers_pool, size_t max_cached_per_class = 64) :
+    pool(buffers_pool),
+    max_cached(std::max(max_cached_per_class, static_cast<size_t>(1))),
+    batch(std::max(max_cached / 2, static_cast<size_t>(1))) {
+        for (auto& li : lists) {
+            li.reserve(max_cached);
+        }
+        std::lock_guard<std::mutex> guard{pool.mtx};
+        pool.caches.push_back(std::addressof(counts));
+    }
+
+    /**
+     * Destructor, returns all cached buffers to pool
+     */
+    ~buffer_cache() STATICLIB_NOEXCEPT {
+        for (size_t i = 0; i < lists.size(); i++) {
+            if (!lists[i].empty()) {
+                pool.give(i, lists[i].data(), lists[i].size());
+            }
+        }
+        std::lock_guard<std::mutex> guard{pool.mtx};
+        auto it = std::find(pool.caches.begin(), pool.caches.end(), std::addressof(counts));
+        if (pool.caches.end() != it) {
+            pool.caches.erase(it);
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    buffer_cache(const buffer_cache&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    buffer_cache& operator=(const buffer_cache&) = delete;
+
+    /**
+     * Takes a buffer of the smallest class, that can hold
+     * the specified number of bytes
+     *
+     * @param size number of bytes
+     * @return buffer, it is returned back to this cache on destruction
+     */
+    pooled_buffer acquire(size_t size) {
+        auto cls = pool.classify(size);
+        if (buffer_class::oversize == cls) {
+            return pool.acquire(size);
+        }
+        size_t idx = static_cast<size_t>(cls);
+        auto& li = lists[idx];
+        if (li.empty()) {
+            li.resize(batch);
+            try {
+                std::lock_guard<std::mutex> guard{pool.mtx};
+                pool.take(idx, li.data(), batch);
+            } catch (...) {
+                li.clear();
+                throw;
+            }
+        }
+        auto ptr = li.back();
+        li.pop_back();
+        counts.set(idx, li.size());
+        return pooled_buffer(std::addressof(pool), this, ptr, size, pool.classes[idx].buffer_size, cls);
+    }
+
+    /**
+     * Number of free buffers of the specified class in this cache
+     *
+     * @param cls pooled size class
+     * @return number of cached buffers
+     */
+    size_t cached_count(buffer_class cls) const {
+        return lists[buffer_pool::index(cls)].size();
+    }
+
+private:
+    void release(pooled_buffer& buf) STATICLIB_NOEXCEPT {
+        size_t idx = static_cast<size_t>(buf.cls);
+        auto& li = lists[idx];
+        if (li.size() >= max_cached) {
+            // keep the newest (hot) half
+            pool.give(idx, li.data(), batch);
+            li.erase(li.begin(), li.begin() + static_cast<std::ptrdiff_t>(batch));
+        }
+        li.push_back(buf.ptr);
+        counts.set(idx, li.size());
+    }
+};
+
+inline void pooled_buffer::reset() STATICLIB_NOEXCEPT {
+    if (nullptr == ptr) {
+        return;
+    }
+    if (nullptr != cache && buffer_class::oversize != cls) {
+        cache->release(*this);
+    } else {
+        pool->release(*this);
+    }
+    ptr = nullptr;
+    len = 0;
+    cap = 0;
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_BUFFER_POOL_HPP */
@@ -0,0 +1,274 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   control_frames.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_CONTROL_FRAMES_HPP
+#define STATICLIB_WEBSOCKET_CONTROL_FRAMES_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/utf8_validator.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+namespace control {
+
+/**
+ * Normal closure
+ */
+const uint16_t close_normal = 1000;
+/**
+ * Endpoint is going away (server shutdown, browser navigation)
+ */
+const uint16_t close_going_away = 1001;
+/**
+ * Protocol error
+ */
+const uint16_t close_protocol_error = 1002;
+/**
+ * Received data type cannot be accepted
+ */
+const uint16_t close_unsupported_data = 1003;
+/**
+ * No status code was present, must not be sent
+ */
+const uint16_t close_no_status = 1005;
+/**
+ * Connection was closed abnormally, must not be sent
+ */
+const uint16_t close_abnormal = 1006;
+/**
+ * Message data was not consistent with its type (invalid UTF-8)
+ */
+const uint16_t close_invalid_payload = 1007;
+/**
+ * Message violates the endpoint policy
+ */
+const uint16_t close_policy_violation = 1008;
+/**
+ * Message is too big to process
+ */
+const uint16_t close_message_too_big = 1009;
+/**
+ * Client expected the server to negotiate an extension
+ */
+const uint16_t close_mandatory_extension = 1010;
+/**
+ * Server encountered an unexpected condition
+ */
+const uint16_t close_internal_error = 1011;
+
+/**
+ * Max length of the close reason (125 bytes minus 2 bytes of status code)
+ */
+const size_t max_close_reason_length = 123;
+
+/**
+ * Result of the close payload parsing
+ */
+enum class close_status {
+    /**
+     * Payload contains valid status code and valid UTF-8 reason
+     */
+    ok,
+    /**
+     * Payload is empty, status code is reported as `close_no_status`
+     */
+    empty,
+    /**
+     * Payload is one byte long, status code must not be sent over the wire,
+     * is unassigned, or reason is not valid UTF-8
+     */
+    invalid
+};
+
+/**
+ * Checks whether close status code can be sent over the wire (RFC 6455 7.4)
+ *
+ * @param code status code
+ * @return `true` for defined codes (except reserved ones) and for
+ *         codes in `3000` - `4999` range
+ */
+inline bool is_valid_close_code(uint16_t code) {
+    return (code >= 1000 && code <= 1003) ||
+            (code >= 1007 && code <= 1014) ||
+            (code >= 3000 && code <= 4999);
+}
+
+/**
+ * Parses close frame payload, does not allocate
+ *
+ * @param payload unmasked payload of the close frame
+ * @param code status code
+ * @param reason span pointing to the close reason in payload
+ * @return parsing status
+ */
+inline close_status parse_close(sl::io::span<const char> payload, uint16_t& code,
+        sl::io::span<const char>& reason) {
+    reason = sl::io::span<const char>(nullptr, 0);
+    if (0 == payload.size()) {
+        code = close_no_status;
+        return close_status::empty;
+    }
+    if (payload.size() < 2 || payload.size() > 125) {
+        code = close_protocol_error;
+        return close_status::invalid;
+    }
+    code = static_cast<uint16_t>((static_cast<uint8_t>(payload.data()[0]) << 8) |
+            static_cast<uint8_t>(payload.data()[1]));
+    if (!is_valid_close_code(code)) {
+        return close_status::invalid;
+    }
+    reason = sl::io::make_span(payload.data() + 2, payload.size() - 2);
+    auto validator = utf8_validator();
+    if (!(validator.update(reason) && validator.is_complete())) {
+        return close_status::invalid;
+    }
+    return close_status::ok;
+}
+
+/**
+ * Writes close frame payload into the specified buffer
+ *
+ * @param buf dest buffer
+ * @param code status code, must be valid for sending
+ * @param reason close reason, UTF-8, up to 123 bytes
+ * @return span pointing to the payload in dest buffer
+ * @throws websocket_exception on invalid code or too long reason
+ */
+inline sl::io::span<char> make_close_payload(std::array<char, 125>& buf, uint16_t code,
+        sl::io::span<const char> reason = sl::io::span<const char>(nullptr, 0)) {
+    if (!is_valid_close_code(code) || reason.size() > max_close_reason_length) {
+        throw websocket_exception(TRACEMSG("Invalid close parameters specified,"
+                " code: [" + sl::support::to_string(code) + "]," +
+                " reason length: [" + sl::support::to_string(reason.size()) + "]"));
+    }
+    buf[0] = static_cast<char>((code >> 8) & 0xff);
+    buf[1] = static_cast<char>(code & 0xff);
+    if (reason.size() > 0) {
+        std::memcpy(buf.data() + 2, reason.data(), reason.size());
+    }
+    return sl::io::make_span(buf.data(), reason.size() + 2);
+}
+
+/**
+ * Pre-encoded unmasked (server-side) ping frame with empty payload
+ *
+ * @return frame bytes
+ */
+inline sl::io::span<const char> ping_frame() {
+    static constexpr char data[] = {'\x89', '\x00'};
+    return sl::io::make_span(data, sizeof(data));
+}
+
+/**
+ * Pre-encoded unmasked (server-side) pong frame with empty payload
+ *
+ * @return frame bytes
+ */
+inline sl::io::span<const char> pong_frame() {
+    static constexpr char data[] = {'\x8a', '\x00'};
+    return sl::io::make_span(data, sizeof(data));
+}
+
+/**
+ * Pre-encoded unmasked (server-side) close frame with `1000` (normal closure) status
+ *
+ * @return frame bytes
+ */
+inline sl::io::span<const char> close_normal_frame() {
+    static constexpr char data[] = {'\x88', '\x02', '\x03', '\xe8'};
+    return sl::io::make_span(data, sizeof(data));
+}
+
+/**
+ * Pre-encoded unmasked (server-side) close frame with `1001` (going away) status
+ *
+ * @return frame bytes
+ */
+inline sl::io::span<const char> close_going_away_frame() {
+    static constexpr char data[] = {'\x88', '\x02', '\x03', '\xe9'};
+    return sl::io::make_span(data, sizeof(data));
+}
+
+/**
+ * Builds an unmasked (server-side) pong frame, that echoes the payload
+ * of the received ping, payload is unmasked directly into the dest buffer
+ *
+ * @param buf dest buffer
+ * @param ping complete ping frame
+ * @return span pointing to the pong frame in dest buffer
+ * @throws websocket_exception if specified frame is not a valid ping
+ */
+inline sl::io::span<char> make_pong(std::array<char, 127>& buf, frame& ping) {
+    if (!(ping.is_complete() && frame_type::ping == ping.type() && ping.payload_length() <= 125)) {
+        throw websocket_exception(TRACEMSG("Invalid ping frame specified,"
+                " header: [" + ping.header_hex() + "]"));
+    }
+    auto pl = ping.payload();
+    buf[0] = static_cast<char>(0x80 | static_cast<uint8_t>(frame_type::pong));
+    buf[1] = static_cast<char>(pl.size());
+    uint32_t mask = ping.is_masked() && !ping.is_unmasked() ? ping.mask_value() : 0;
+    apply_mask(pl.data(), buf.data() + 2, pl.size(), mask);
+    return sl::io::make_span(buf.data(), pl.size() + 2);
+}
+
+/**
+ * Builds a masked (client-side) pong frame, that echoes the payload
+ * of the received ping
+ *
+ * @param buf dest buffer
+ * @param ping complete ping frame
+ * @param mask_val masking key for the pong, must not be zero
+ * @return span pointing to the pong frame in dest buffer
+ * @throws websocket_exception if specified frame is not a valid ping
+ */
+inline sl::io::span<char> make_pong(std::array<char, 131>& buf, frame& ping, uint32_t mask_val) {
+    if (!(ping.is_complete() && frame_type::ping == ping.type() && ping.payload_length() <= 125) ||
+            0 == mask_val) {
+        throw websocket_exception(TRACEMSG("Invalid ping frame or mask specified,"
+                " header: [" + ping.header_hex() + "]"));
+    }
+    auto pl = ping.payload();
+    uint32_t ping_mask = ping.is_masked() && !ping.is_unmasked() ? ping.mask_value() : 0;
+    buf[0] = static_cast<char>(0x80 | static_cast<uint8_t>(frame_type::pong));
+    buf[1] = static_cast<char>(0x80 | pl.size());
+    buf[2] = static_cast<char>((mask_val >> 24) & 0xff);
+    buf[3] = static_cast<char>((mask_val >> 16) & 0xff);
+    buf[4] = static_cast<char>((mask_val >> 8) & 0xff);
+    buf[5] = static_cast<char>(mask_val & 0xff);
+    // both masks are applied in one pass
+    apply_mask(pl.data(), buf.data() + 6, pl.size(), ping_mask ^ mask_val);
+    return sl::io::make_span(buf.data(), pl.size() + 6);
+}
+
+} // namespace
+}
+}
+
+#endif /* STATICLIB_WEBSOCKET_CONTROL_FRAMES_HPP */
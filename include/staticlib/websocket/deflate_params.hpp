@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   deflate_params.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_DEFLATE_PARAMS_HPP
+#define STATICLIB_WEBSOCKET_DEFLATE_PARAMS_HPP
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Parameters of the "permessage-deflate" extension (RFC 7692),
+ * used both as a local configuration and as a negotiation result
+ */
+struct deflate_params {
+    /**
+     * Server resets its compression context after each message
+     */
+    bool server_no_context_takeover = false;
+    /**
+     * Client resets its compression context after each message
+     */
+    bool client_no_context_takeover = false;
+    /**
+     * LZ77 window size (base 2 logarithm) used by server for compression,
+     * `8` - `15`
+     */
+    int server_max_window_bits = 15;
+    /**
+     * LZ77 window size (base 2 logarithm) used by client for compression,
+     * `8` - `15`
+     */
+    int client_max_window_bits = 15;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_DEFLATE_PARAMS_HPP */
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   encoded_frame.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_ENCODED_FRAME_HPP
+#define STATICLIB_WEBSOCKET_ENCODED_FRAME_HPP
+
+#include <cstring>
+#include <array>
+#include <memory>
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/buffer_pool.hpp"
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Immutable unmasked (server-side) frame with header and payload
+ * stored in a single buffer. Intended to be shared (through `std::shared_ptr`)
+ * between the send queues of all the recipients of the same message,
+ * so the message is encoded only once.
+ */
+class encoded_frame {
+    std::unique_ptr<char[]> buffer;
+    pooled_buffer pooled;
+    char* bytes;
+    size_t header_len;
+    size_t total_len;
+    frame_type ftype;
+
+public:
+    /**
+     * Constructor, encodes the frame
+     *
+     * @param fr_type frame type
+     * @param payload frame payload, is copied into the frame buffer
+     * @param compressed whether RSV1 bit should be set (payload is already compressed
+     *        with "permessage-deflate")
+     */
+    encoded_frame(frame_type fr_type, sl::io::span<const char> payload, bool compressed = false) :
+    ftype(fr_type) {
+        auto hbuf = std::array<char, 10>();
+        auto header = frame::make_header(hbuf, fr_type, payload.size(), false, false, compressed);
+        this->buffer = std::unique_ptr<char[]>(new char[header.size() + payload.size()]);
+        this->bytes = buffer.get();
+        encode(header, payload);
+    }
+
+    /**
+     * Constructor, encodes the frame into the buffer taken from the pool,
+     * buffer is returned to the pool when the frame is destroyed
+     * (on any thread)
+     *
+     * @param pool buffers pool, must outlive this frame
+     * @param fr_type frame type
+     * @param payload frame payload, is copied into the frame buffer
+     * @param compressed whether RSV1 bit should be set (payload is already compressed
+     *        with "permessage-deflate")
+     */
+    encoded_frame(buffer_pool& pool, frame_type fr_type, sl::io::span<const char> payload,
+            bool compressed = false) :
+    ftype(fr_type) {
+        auto hbuf = std::array<char, 10>();
+        auto header = frame::make_header(hbuf, fr_type, payload.size(), false, false, compressed);
+        this->pooled = pool.acquire(header.size() + payload.size());
+        this->bytes = pooled.data();
+        encode(header, payload);
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    encoded_frame(const encoded_frame&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    encoded_frame& operator=(const encoded_frame&) = delete;
+
+    /**
+     * Frame type accessor
+     *
+     * @return frame type
+     */
+    frame_type type() const {
+        return ftype;
+    }
+
+    /**
+     * Encoded frame bytes (header followed by payload), ready to be sent
+     *
+     * @return frame bytes
+     */
+    sl::io::span<const char> data() const {
+        return sl::io::make_span(const_cast<const char*>(bytes), total_len);
+    }
+
+    /**
+     * Frame header bytes
+     *
+     * @return header bytes
+     */
+    sl::io::span<const char> header() const {
+        return sl::io::make_span(const_cast<const char*>(bytes), header_len);
+    }
+
+    /**
+     * Frame payload bytes
+     *
+     * @return payload bytes
+     */
+    sl::io::span<const char> payload() const {
+        return sl::io::make_span(const_cast<const char*>(bytes) + header_len, total_len - header_len);
+    }
+
+    /**
+     * Size of the encoded frame in bytes
+     *
+     * @return size of the frame
+     */
+    size_t size() const {
+        return total_len;
+    }
+
+private:
+    void encode(sl::io::span<const char> header, sl::io::span<const char> payload) {
+        this->header_len = header.size();
+        this->total_len = header_len + payload.size();
+        std::memcpy(bytes, header.data(), header_len);
+        if (payload.size() > 0) {
+            std::memcpy(bytes + header_len, payload.data(), payload.size());
+        }
+    }
+};
+
+/**
+ * Encodes the frame into a shared immutable buffer
+ *
+ * @param fr_type frame type
+ * @param payload frame payload, is copied into the frame buffer
+ * @param compressed whether RSV1 bit should be set
+ * @return shared encoded frame
+ */
+inline std::shared_ptr<const encoded_frame> make_encoded_frame(frame_type fr_type,
+        sl::io::span<const char> payload, bool compressed = false) {
+    return std::make_shared<const encoded_frame>(fr_type, payload, compressed);
+}
+
+/**
+ * Encodes the frame into a shared immutable buffer taken from the pool
+ *
+ * @param pool buffers pool, must outlive the frame
+ * @param fr_type frame type
+ * @param payload frame payload, is copied into the frame buffer
+ * @param compressed whether RSV1 bit should be set
+ * @return shared encoded frame
+ */
+inline std::shared_ptr<const encoded_frame> make_encoded_frame(buffer_pool& pool, frame_type fr_type,
+        sl::io::span<const char> payload, bool compressed = false) {
+    return std::make_shared<const encoded_frame>(pool, fr_type, payload, compressed);
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_ENCODED_FRAME_HPP */
@@ -0,0 +1,1115 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   epoll_server.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_EPOLL_SERVER_HPP
+#define STATICLIB_WEBSOCKET_EPOLL_SERVER_HPP
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_LINUX
+#error "'epoll_server.hpp' is supported only on Linux"
+#endif // !STATICLIB_LINUX
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/control_frames.hpp"
+#include "staticlib/websocket/encoded_frame.hpp"
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_encoder.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/handshake.hpp"
+#include "staticlib/websocket/message_assembler.hpp"
+#include "staticlib/websocket/role.hpp"
+#include "staticlib/websocket/segment_pool.hpp"
+#include "staticlib/websocket/upgrade_request.hpp"
+#include "staticlib/websocket/utf8_validator.hpp"
+#include "staticlib/websocket/vectored_encoder.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Configuration of the reference epoll server
+ */
+struct epoll_server_config {
+    /**
+     * IPv4 address to listen on
+     */
+    std::string address = "0.0.0.0";
+    /**
+     * TCP port to listen on, with `0` the port is chosen
+     * by the OS and can be obtained with `epoll_server::port()`
+     */
+    uint16_t port = 8080;
+    /**
+     * Number of event loops (each with its own thread, epoll instance
+     * and `SO_REUSEPORT` listening socket), `0` - one loop per core
+     */
+    size_t threads = 0;
+    /**
+     * Whether each loop thread needs to be pinned to a separate core
+     */
+    bool pin_threads = false;
+    /**
+     * Listen backlog of each listening socket
+     */
+    int backlog = 1024;
+    /**
+     * Initial size of the per-connection read buffer, buffer grows
+     * up to the max message size when large frames are received
+     */
+    size_t read_buffer_size = 16384;
+    /**
+     * Max size of the incoming message (and of a single incoming frame)
+     */
+    size_t max_message_size = 1 << 24;
+    /**
+     * Max size of the upgrade request head
+     */
+    size_t max_request_size = handshake::default_max_request_size;
+    /**
+     * Max number of bytes queued for sending to a single connection,
+     * `send()` fails and reading is paused when this limit is reached
+     */
+    size_t max_write_queue = 1 << 22;
+    /**
+     * Ping is sent when nothing was received from the connection during this interval
+     */
+    uint32_t ping_interval_ms = 30000;
+    /**
+     * Connection is dropped when nothing was received from it during
+     * this interval (also limits the handshake duration)
+     */
+    uint32_t idle_timeout_ms = 60000;
+    /**
+     * Connection is dropped when the close handshake initiated by
+     * the server is not finished during this interval
+     */
+    uint32_t close_timeout_ms = 5000;
+    /**
+     * Interval of the keepalive and timeouts checks
+     */
+    uint32_t tick_ms = 1000;
+};
+
+namespace detail_epoll {
+
+template<typename Handler>
+class event_loop;
+
+inline uint64_t now_millis() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline std::string error_message() {
+    return std::string(std::strerror(errno)) + " (" + sl::support::to_string(errno) + ")";
+}
+
+const char bad_request[] = "HTTP/1.1 400 Bad Request\r\n"
+        "Connection: close\r\n"
+        "Content-Length: 0\r\n"
+        "\r\n";
+
+/**
+ * Max number of segments written with a single `sendmsg` call
+ */
+const size_t max_write_segments = 64;
+
+/**
+ * Element of the connection write queue: either the run of bytes
+ * copied into the connection buffer, or the shared encoded frame,
+ * that is referenced without copying
+ */
+struct write_segment {
+    std::shared_ptr<const encoded_frame> encoded;
+    size_t len;
+    size_t offset;
+
+    write_segment(std::shared_ptr<const encoded_frame> encoded, size_t len) :
+    encoded(std::move(encoded)),
+    len(len),
+    offset(0) { }
+};
+
+} // namespace
+
+/**
+ * Connection accepted by `epoll_server`, handler callbacks receive
+ * the reference to it. All methods must be called only from
+ * the loop thread that owns the connection (from handler callbacks).
+ * Connection reference is valid until `on_close` callback returns.
+ */
+class epoll_connection {
+    template<typename Handler>
+    friend class detail_epoll::event_loop;
+
+    enum class conn_state {
+        handshake, open, closing, dropped
+    };
+
+    int sock;
+    uint64_t conn_id;
+    conn_state state = conn_state::handshake;
+    std::vector<char> rbuf;
+    size_t rlen = 0;
+    std::vector<char> wbuf;
+    size_t woffset = 0;
+    std::deque<detail_epoll::write_segment> wqueue;
+    size_t wqueue_bytes = 0;
+    std::vector<int>* dirty_list = nullptr;
+    size_t max_queue;
+    handshake::upgrade_request request;
+    message_assembler assembler;
+    bool fragmented = false;
+    bool opened = false;
+    bool close_sent = false;
+    bool close_received = false;
+    bool discard_input = false;
+    bool write_shut = false;
+    bool read_paused = false;
+    bool dirty = false;
+    uint16_t close_code = control::close_abnormal;
+    uint64_t last_read;
+    uint64_t last_ping = 0;
+    uint64_t close_sent_at = 0;
+
+public:
+    /**
+     * Constructor, called by server
+     *
+     * @param fd accepted socket
+     * @param id connection ID
+     * @param pool segment pool of the loop
+     * @param config server config
+     */
+    epoll_connection(int fd, uint64_t id, segment_pool& pool, const epoll_server_config& config) :
+    sock(fd),
+    conn_id(id),
+    rbuf(config.read_buffer_size),
+    max_queue(config.max_write_queue),
+    assembler(pool, config.max_message_size),
+    last_read(detail_epoll::now_millis()) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    epoll_connection(const epoll_connection&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    epoll_connection& operator=(const epoll_connection&) = delete;
+
+    /**
+     * Connection ID, unique within the server
+     *
+     * @return connection ID
+     */
+    uint64_t id() const {
+        return conn_id;
+    }
+
+    /**
+     * Socket file descriptor
+     *
+     * @return socket
+     */
+    int fd() const {
+        return sock;
+    }
+
+    /**
+     * Flag shows whether messages can be sent to this connection
+     *
+     * @return `true` if handshake is done and close is not started
+     */
+    bool is_open() const {
+        return conn_state::open == state;
+    }
+
+    /**
+     * Upgrade request of this connection, can be accessed only
+     * from the `on_open` callback, spans are cleared after it returns
+     *
+     * @return upgrade request
+     */
+    const handshake::upgrade_request& handshake_request() const {
+        return request;
+    }
+
+    /**
+     * Number of bytes queued for sending
+     *
+     * @return number of queued bytes
+     */
+    size_t write_queue_size() const {
+        return wqueue_bytes;
+    }
+
+    /**
+     * Queues the unfragmented message for sending, queued data is written
+     * to socket at the end of the current loop iteration, so multiple
+     * messages are coalesced into a single write
+     *
+     * @param fr_type frame type
+     * @param payload message payload
+     * @return `false` if connection is not open or write queue limit is reached
+     */
+    bool send(frame_type fr_type, sl::io::span<const char> payload) {
+        if (!is_open() || write_queue_size() + payload.size() > max_queue) {
+            return false;
+        }
+        auto head_buf = std::array<char, 10>();
+        auto head = frame_encoder<server_role>::make_header(head_buf, fr_type, payload.size());
+        enqueue(head);
+        enqueue(payload);
+        return true;
+    }
+
+    /**
+     * Queues the encoded (shared) frame for sending, frame is not copied,
+     * it is kept in the queue until it is written to socket
+     *
+     * @param frame frame encoded with `make_encoded_frame`
+     * @return `false` if connection is not open or write queue limit is reached
+     */
+    bool send(const std::shared_ptr<const encoded_frame>& frame) {
+        if (!is_open() || write_queue_size() + frame->size() > max_queue) {
+            return false;
+        }
+        wqueue.emplace_back(frame, frame->size());
+        this->wqueue_bytes += frame->size();
+        mark_dirty();
+        return true;
+    }
+
+    /**
+     * Starts the close handshake, connection is dropped when the client
+     * replies with the close frame or after the close timeout
+     *
+     * @param code close status code
+     * @param reason close reason, UTF-8, up to 123 bytes
+     */
+    void close(uint16_t code = control::close_normal,
+            sl::io::span<const char> reason = sl::io::span<const char>(nullptr, 0)) {
+        if (conn_state::open != state) {
+            return;
+        }
+        send_close(code, reason);
+    }
+
+private:
+    void enqueue(sl::io::span<const char> data) {
+        if (0 == woffset && wbuf.empty()) {
+            wbuf.reserve(data.size());
+        }
+        wbuf.insert(wbuf.end(), data.data(), data.data() + data.size());
+        if (!wqueue.empty() && nullptr == wqueue.back().encoded.get()) {
+            wqueue.back().len += data.size();
+        } else {
+            wqueue.emplace_back(nullptr, data.size());
+        }
+        this->wqueue_bytes += data.size();
+        mark_dirty();
+    }
+
+    // loop flushes only the connections from its dirty list
+    void mark_dirty() {
+        if (!dirty) {
+            this->dirty = true;
+            if (nullptr != dirty_list) {
+                dirty_list->push_back(sock);
+            }
+        }
+    }
+
+    void send_close(uint16_t code, sl::io::span<const char> reason) {
+        auto pl_buf = std::array<char, 125>();
+        auto pl = sl::io::make_span(pl_buf.data(), 0);
+        if (control::is_valid_close_code(code)) {
+            pl = control::make_close_payload(pl_buf, code, reason.size() <= control::max_close_reason_length ?
+                    reason : sl::io::span<const char>(nullptr, 0));
+        }
+        auto head_buf = std::array<char, 10>();
+        enqueue(frame_encoder<server_role>::make_header(head_buf, frame_type::close, pl.size()));
+        enqueue(pl);
+        this->state = conn_state::closing;
+        this->close_sent = true;
+        this->close_sent_at = detail_epoll::now_millis();
+    }
+};
+
+namespace detail_epoll {
+
+/**
+ * Single-threaded event loop: owns the listening socket (shared
+ * with other loops through `SO_REUSEPORT`), epoll instance
+ * and all the accepted connections
+ */
+template<typename Handler>
+class event_loop {
+    const epoll_server_config& config;
+    Handler& handler;
+    std::atomic<uint64_t>& id_counter;
+    int listener;
+    int epfd = -1;
+    int stopfd = -1;
+    segment_pool pool;
+    std::unordered_map<int, std::unique_ptr<epoll_connection>> connections;
+    std::vector<int> dirty;
+    std::vector<char> scratch;
+    vectored_encoder<max_write_segments> wbatch;
+    uint64_t last_tick = 0;
+    bool accept_pending = false;
+    // addresses are used as epoll tags
+    char listener_tag = 0;
+    char stop_tag = 0;
+
+public:
+    event_loop(const epoll_server_config& config, Handler& handler, std::atomic<uint64_t>& id_counter,
+            int listener) :
+    config(config),
+    handler(handler),
+    id_counter(id_counter),
+    listener(listener) {
+        this->epfd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (-1 == epfd) {
+            throw websocket_exception(TRACEMSG("'epoll_create1' error: [" + error_message() + "]"));
+        }
+        this->stopfd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (-1 == stopfd) {
+            auto msg = error_message();
+            ::close(epfd);
+            throw websocket_exception(TRACEMSG("'eventfd' error: [" + msg + "]"));
+        }
+        add_to_epoll(listener, EPOLLIN | EPOLLET, std::addressof(listener_tag));
+        add_to_epoll(stopfd, EPOLLIN, std::addressof(stop_tag));
+    }
+
+    ~event_loop() STATICLIB_NOEXCEPT {
+        ::close(stopfd);
+        ::close(epfd);
+        ::close(listener);
+    }
+
+    event_loop(const event_loop&) = delete;
+
+    event_loop& operator=(const event_loop&) = delete;
+
+    void run() {
+        auto events = std::array<struct epoll_event, 256>();
+        bool running = true;
+        this->last_tick = now_millis();
+        while (running) {
+            int count = ::epoll_wait(epfd, events.data(), static_cast<int>(events.size()),
+                    static_cast<int>(config.tick_ms));
+            if (-1 == count && EINTR != errno) {
+                break;
+            }
+            for (int i = 0; i < count; i++) {
+                auto& ev = events[i];
+                if (std::addressof(stop_tag) == ev.data.ptr) {
+                    running = false;
+                } else if (std::addressof(listener_tag) == ev.data.ptr) {
+                    accept_all();
+                } else {
+                    handle_event(*static_cast<epoll_connection*>(ev.data.ptr), ev.events);
+                }
+            }
+            flush_dirty();
+            if (accept_pending) {
+                // listener is edge-triggered, backlog is not reported again
+                accept_all();
+                flush_dirty();
+            }
+            auto now = now_millis();
+            if (now - last_tick >= config.tick_ms) {
+                this->last_tick = now;
+                check_timeouts(now);
+                flush_dirty();
+            }
+        }
+        drop_all();
+    }
+
+    void stop() {
+        uint64_t one = 1;
+        auto written = ::write(stopfd, std::addressof(one), sizeof(one));
+        (void) written;
+    }
+
+private:
+    void add_to_epoll(int fd, uint32_t events, void* tag) {
+        struct epoll_event ev;
+        std::memset(std::addressof(ev), '\0', sizeof(ev));
+        ev.events = events;
+        ev.data.ptr = tag;
+        if (-1 == ::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, std::addressof(ev))) {
+            throw websocket_exception(TRACEMSG("'epoll_ctl' error: [" + error_message() + "]"));
+        }
+    }
+
+    void accept_all() {
+        for (;;) {
+            int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (-1 == fd) {
+                if (EINTR == errno || ECONNABORTED == errno) {
+                    continue;
+                }
+                // EAGAIN clears the flag, on resources exhaustion (EMFILE, ENFILE, ENOBUFS)
+                // remaining connections stay in backlog and accept is retried
+                // on the next loop iteration
+                this->accept_pending = EAGAIN != errno && EWOULDBLOCK != errno;
+                return;
+            }
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, std::addressof(one), sizeof(one));
+            auto conn = std::unique_ptr<epoll_connection>(new epoll_connection(fd, id_counter++, pool, config));
+            conn->dirty_list = std::addressof(dirty);
+            struct epoll_event ev;
+            std::memset(std::addressof(ev), '\0', sizeof(ev));
+            ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            ev.data.ptr = conn.get();
+            if (-1 == ::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, std::addressof(ev))) {
+                ::close(fd);
+                continue;
+            }
+            connections[fd] = std::move(conn);
+        }
+    }
+
+    void handle_event(epoll_connection& conn, uint32_t events) {
+        int fd = conn.sock;
+        if (0 != (events & EPOLLIN)) {
+            read_all(conn);
+        }
+        if (epoll_connection::conn_state::dropped != conn.state &&
+                0 != (events & (EPOLLERR | EPOLLHUP))) {
+            conn.state = epoll_connection::conn_state::dropped;
+        }
+        if (epoll_connection::conn_state::dropped != conn.state && 0 != (events & EPOLLOUT)) {
+            flush(conn);
+        }
+        if (epoll_connection::conn_state::dropped == conn.state) {
+            drop(fd);
+        }
+    }
+
+    // reads until EAGAIN, edge-triggered notifications require draining the socket
+    void read_all(epoll_connection& conn) {
+        while (epoll_connection::conn_state::dropped != conn.state) {
+            if (conn.write_queue_size() >= config.max_write_queue) {
+                // backpressure: reading is resumed when write queue is flushed
+                conn.read_paused = true;
+                return;
+            }
+            if (conn.rlen == conn.rbuf.size()) {
+                conn.rbuf.resize(conn.rbuf.size() * 2);
+            }
+            auto read = ::recv(conn.sock, conn.rbuf.data() + conn.rlen, conn.rbuf.size() - conn.rlen, 0);
+            if (read > 0) {
+                conn.rlen += static_cast<size_t>(read);
+                conn.last_read = now_millis();
+                process_input(conn);
+            } else if (0 == read) {
+                conn.state = epoll_connection::conn_state::dropped;
+            } else if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                return;
+            } else if (EINTR != errno) {
+                conn.state = epoll_connection::conn_state::dropped;
+            }
+        }
+    }
+
+    void process_input(epoll_connection& conn) {
+        size_t pos = 0;
+        if (epoll_connection::conn_state::handshake == conn.state) {
+            pos = process_handshake(conn);
+        }
+        while (epoll_connection::conn_state::open == conn.state ||
+                (epoll_connection::conn_state::closing == conn.state && !conn.close_received &&
+                        !conn.discard_input)) {
+            auto avail = conn.rlen - pos;
+            if (0 == avail) {
+                break;
+            }
+            auto fr = frame({conn.rbuf.data() + pos, avail});
+            if (!fr.is_well_formed()) {
+                fail(conn, control::close_protocol_error);
+                break;
+            }
+            if (!fr.is_header_complete()) {
+                break;
+            }
+            if (!fr.conforms_to<server_role>()) {
+                fail(conn, control::close_protocol_error);
+                break;
+            }
+            if (fr.payload_length() > config.max_message_size) {
+                fail(conn, control::close_message_too_big);
+                break;
+            }
+            if (!fr.is_complete()) {
+                // buffer must hold the whole frame
+                auto fsize = static_cast<size_t>(fr.size());
+                if (conn.rbuf.size() < fsize) {
+                    conn.rbuf.resize(fsize);
+                }
+                break;
+            }
+            auto fsize = static_cast<size_t>(fr.size());
+            auto payload = fr.unmask_in_place({conn.rbuf.data() + pos, fsize});
+            handle_frame(conn, fr, payload);
+            pos += fsize;
+        }
+        if (epoll_connection::conn_state::closing == conn.state && (conn.close_received || conn.discard_input)) {
+            // remaining input is ignored after the close frame or after the error
+            pos = conn.rlen;
+        }
+        if (pos > 0) {
+            std::memmove(conn.rbuf.data(), conn.rbuf.data() + pos, conn.rlen - pos);
+            conn.rlen -= pos;
+        }
+    }
+
+    size_t process_handshake(epoll_connection& conn) {
+        auto status = handshake::parse_request({conn.rbuf.data(), conn.rlen}, conn.request,
+                config.max_request_size);
+        switch (status) {
+        case handshake::request_status::incomplete:
+            return 0;
+        case handshake::request_status::complete: {
+            auto resp = std::array<char, 256>();
+            auto len = handshake::write_response(conn.request.key, {resp.data(), resp.size()});
+            conn.enqueue({resp.data(), len});
+            conn.state = epoll_connection::conn_state::open;
+            conn.opened = true;
+            auto head_len = conn.request.head_length;
+            invoke_open(conn);
+            // spans point into the read buffer that is going to be compacted
+            conn.request = handshake::upgrade_request();
+            return head_len;
+        }
+        default:
+            conn.enqueue({detail_epoll::bad_request, sizeof(detail_epoll::bad_request) - 1});
+            conn.state = epoll_connection::conn_state::closing;
+            conn.discard_input = true;
+            conn.close_sent_at = now_millis();
+            return conn.rlen;
+        }
+    }
+
+    void handle_frame(epoll_connection& conn, frame& fr, sl::io::span<char> payload) {
+        switch (fr.type()) {
+        case frame_type::ping:
+            if (epoll_connection::conn_state::open == conn.state) {
+                auto head_buf = std::array<char, 10>();
+                conn.enqueue(frame_encoder<server_role>::make_header(head_buf, frame_type::pong, payload.size()));
+                conn.enqueue(payload);
+            }
+            return;
+        case frame_type::pong:
+            return;
+        case frame_type::close:
+            handle_close(conn, payload);
+            return;
+        default:
+            break;
+        }
+        // unfragmented messages are delivered directly from the read buffer
+        if (fr.is_final() && frame_type::continuation != fr.type() && !conn.fragmented) {
+            if (frame_type::text == fr.type()) {
+                auto validator = utf8_validator();
+                if (!(validator.update(payload) && validator.is_complete())) {
+                    fail(conn, control::close_invalid_payload);
+                    return;
+                }
+            }
+            invoke_message(conn, fr.type(), payload);
+            return;
+        }
+        switch (conn.assembler.accept(fr)) {
+        case message_status::incomplete:
+            conn.fragmented = true;
+            return;
+        case message_status::complete: {
+            conn.fragmented = false;
+            if (scratch.size() < conn.assembler.size()) {
+                scratch.resize(conn.assembler.size());
+            }
+            auto msg = conn.assembler.flatten({scratch.data(), scratch.size()});
+            auto msg_type = conn.assembler.type();
+            conn.assembler.clear();
+            invoke_message(conn, msg_type, msg);
+            return;
+        }
+        case message_status::too_big:
+            fail(conn, control::close_message_too_big);
+            return;
+        case message_status::invalid_utf8:
+            fail(conn, control::close_invalid_payload);
+            return;
+        default:
+            fail(conn, control::close_protocol_error);
+            return;
+        }
+    }
+
+    void handle_close(epoll_connection& conn, sl::io::span<char> payload) {
+        conn.close_received = true;
+        uint16_t code = control::close_no_status;
+        auto reason = sl::io::span<const char>(nullptr, 0);
+        auto st = control::parse_close(payload, code, reason);
+        if (control::close_status::invalid == st) {
+            code = control::close_protocol_error;
+        }
+        conn.close_code = code;
+        if (!conn.close_sent) {
+            // echo the status code, RFC 6455 5.5.1, empty close
+            // is answered with empty close (close_no_status is not sent)
+            conn.send_close(code, sl::io::span<const char>(nullptr, 0));
+        }
+        conn.state = epoll_connection::conn_state::closing;
+    }
+
+    void fail(epoll_connection& conn, uint16_t code) {
+        conn.close_code = code;
+        if (!conn.close_sent) {
+            conn.send_close(code, sl::io::span<const char>(nullptr, 0));
+        }
+        // input stream cannot be trusted after the error, it is discarded
+        // until the client closes the connection or close timeout expires
+        conn.discard_input = true;
+        conn.state = epoll_connection::conn_state::closing;
+    }
+
+    void invoke_open(epoll_connection& conn) {
+        try {
+            handler.on_open(conn);
+        } catch (const std::exception&) {
+            fail(conn, control::close_internal_error);
+        }
+    }
+
+    void invoke_message(epoll_connection& conn, frame_type fr_type, sl::io::span<const char> payload) {
+        try {
+            handler.on_message(conn, fr_type, payload);
+        } catch (const std::exception&) {
+            fail(conn, control::close_internal_error);
+        }
+    }
+
+    void flush(epoll_connection& conn) {
+        write_out(conn);
+        // input read after resuming may produce replies, that are written
+        // right away instead of waiting for the next event
+        while (epoll_connection::conn_state::dropped != conn.state &&
+                conn.read_paused && conn.write_queue_size() < config.max_write_queue) {
+            conn.read_paused = false;
+            read_all(conn);
+            if (epoll_connection::conn_state::dropped != conn.state) {
+                conn.dirty = false;
+                write_out(conn);
+            }
+        }
+    }
+
+    void write_out(epoll_connection& conn) {
+        while (conn.write_queue_size() > 0) {
+            auto iov = std::array<struct iovec, max_write_segments>();
+            struct msghdr msg;
+            std::memset(std::addressof(msg), '\0', sizeof(msg));
+            msg.msg_iov = iov.data();
+            msg.msg_iovlen = prepare_batch(conn, iov);
+            auto written = ::sendmsg(conn.sock, std::addressof(msg), MSG_NOSIGNAL);
+            if (written > 0) {
+                consume_written(conn, static_cast<size_t>(written));
+            } else if (-1 == written && (EAGAIN == errno || EWOULDBLOCK == errno)) {
+                break;
+            } else if (-1 == written && EINTR == errno) {
+                continue;
+            } else {
+                conn.state = epoll_connection::conn_state::dropped;
+                return;
+            }
+        }
+        if (0 == conn.write_queue_size()) {
+            conn.wbuf.clear();
+            conn.woffset = 0;
+            if (epoll_connection::conn_state::closing == conn.state && conn.close_received) {
+                // close handshake is finished, server closes TCP connection first
+                conn.state = epoll_connection::conn_state::dropped;
+                return;
+            }
+            if (epoll_connection::conn_state::closing == conn.state && conn.discard_input && !conn.write_shut) {
+                // lingering close: closing the socket with unread input would reset the connection
+                ::shutdown(conn.sock, SHUT_WR);
+                conn.write_shut = true;
+            }
+        } else if (conn.woffset > conn.wbuf.size() / 2) {
+            conn.wbuf.erase(conn.wbuf.begin(), conn.wbuf.begin() + static_cast<std::ptrdiff_t>(conn.woffset));
+            conn.woffset = 0;
+        }
+    }
+
+    // shared frames are written from their own buffers, without copying into wbuf
+    size_t prepare_batch(epoll_connection& conn, std::array<struct iovec, max_write_segments>& iov) {
+        wbatch.clear();
+        size_t wpos = conn.woffset;
+        for (auto& seg : conn.wqueue) {
+            if (0 == wbatch.frames_available()) {
+                break;
+            }
+            if (nullptr != seg.encoded.get()) {
+                wbatch.add_encoded({seg.encoded->data().data() + seg.offset, seg.len - seg.offset});
+            } else {
+                wbatch.add_encoded({conn.wbuf.data() + wpos, seg.len});
+                wpos += seg.len;
+            }
+        }
+        return wbatch.to_iovec(iov.data(), iov.size());
+    }
+
+    void consume_written(epoll_connection& conn, size_t written) {
+        conn.wqueue_bytes -= written;
+        while (written > 0) {
+            auto& seg = conn.wqueue.front();
+            if (nullptr != seg.encoded.get()) {
+                size_t len = written < seg.len - seg.offset ? written : seg.len - seg.offset;
+                seg.offset += len;
+                written -= len;
+                if (seg.offset == seg.len) {
+                    conn.wqueue.pop_front();
+                }
+            } else {
+                size_t len = written < seg.len ? written : seg.len;
+                conn.woffset += len;
+                seg.len -= len;
+                written -= len;
+                if (0 == seg.len) {
+                    conn.wqueue.pop_front();
+                }
+            }
+        }
+    }
+
+    void flush_dirty() {
+        // list may grow while flushing, when resumed reads produce replies
+        for (size_t i = 0; i < dirty.size(); i++) {
+            int fd = dirty[i];
+            auto it = connections.find(fd);
+            if (connections.end() == it || !it->second->dirty) {
+                continue;
+            }
+            auto& conn = *it->second;
+            conn.dirty = false;
+            if (epoll_connection::conn_state::dropped != conn.state) {
+                flush(conn);
+            }
+            if (epoll_connection::conn_state::dropped == conn.state) {
+                drop(fd);
+            }
+        }
+        dirty.clear();
+    }
+
+    void check_timeouts(uint64_t now) {
+        auto expired = std::vector<int>();
+        for (auto& en : connections) {
+            auto& conn = *en.second;
+            auto idle = now - conn.last_read;
+            if (epoll_connection::conn_state::closing == conn.state) {
+                if (now - conn.close_sent_at > config.close_timeout_ms) {
+                    expired.push_back(en.first);
+                }
+            } else if (idle > config.idle_timeout_ms) {
+                expired.push_back(en.first);
+            } else if (epoll_connection::conn_state::open == conn.state && idle > config.ping_interval_ms &&
+                    now - conn.last_ping > config.ping_interval_ms) {
+                conn.enqueue(control::ping_frame());
+                conn.last_ping = now;
+            }
+        }
+        for (int fd : expired) {
+            drop(fd);
+        }
+    }
+
+    void drop(int fd) {
+        auto it = connections.find(fd);
+        if (connections.end() == it) {
+            return;
+        }
+        auto conn = std::move(it->second);
+        connections.erase(it);
+        ::close(fd);
+        if (conn->opened) {
+            try {
+                handler.on_close(*conn, conn->close_code);
+            } catch (const std::exception&) {
+                // connection is already closed
+            }
+        }
+    }
+
+    void drop_all() {
+        auto fds = std::vector<int>();
+        for (auto& en : connections) {
+            if (!en.second->close_received) {
+                en.second->close_code = control::close_going_away;
+            }
+            fds.push_back(en.first);
+        }
+        for (int fd : fds) {
+            drop(fd);
+        }
+    }
+};
+
+inline int open_listener(const epoll_server_config& config, uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (-1 == fd) {
+        throw websocket_exception(TRACEMSG("'socket' error: [" + error_message() + "]"));
+    }
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, std::addressof(one), sizeof(one));
+    if (-1 == ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, std::addressof(one), sizeof(one))) {
+        auto msg = error_message();
+        ::close(fd);
+        throw websocket_exception(TRACEMSG("'SO_REUSEPORT' error: [" + msg + "]"));
+    }
+    struct sockaddr_in addr;
+    std::memset(std::addressof(addr), '\0', sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (1 != ::inet_pton(AF_INET, config.address.c_str(), std::addressof(addr.sin_addr))) {
+        ::close(fd);
+        throw websocket_exception(TRACEMSG("Invalid listen address specified,"
+                " address: [" + config.address + "]"));
+    }
+    if (-1 == ::bind(fd, reinterpret_cast<struct sockaddr*>(std::addressof(addr)), sizeof(addr)) ||
+            -1 == ::listen(fd, config.backlog)) {
+        auto msg = error_message();
+        ::close(fd);
+        throw websocket_exception(TRACEMSG("Listen error, address: [" + config.address + "]," +
+                " port: [" + sl::support::to_string(port) + "], error: [" + msg + "]"));
+    }
+    return fd;
+}
+
+inline uint16_t bound_port(int fd) {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    if (-1 == ::getsockname(fd, reinterpret_cast<struct sockaddr*>(std::addressof(addr)), std::addressof(len))) {
+        throw websocket_exception(TRACEMSG("'getsockname' error: [" + error_message() + "]"));
+    }
+    return ntohs(addr.sin_port);
+}
+
+} // namespace
+
+/**
+ * Reference server engine built on top of `handshake`, `frame` and
+ * `message_assembler`: non-blocking sockets, edge-triggered epoll,
+ * one event loop per core, connections are sharded between loops
+ * by the kernel using `SO_REUSEPORT` listening sockets.
+ *
+ * Handles the upgrade handshake, frame parsing (including fragmented
+ * messages and UTF-8 validation), ping/pong keepalives, idle timeouts,
+ * close handshake and write backpressure. Extensions are not negotiated.
+ *
+ * Handler must have the following methods, that are called from loop
+ * threads concurrently (one handler instance is shared by all loops):
+ *
+ * - `void on_open(epoll_connection& conn)`
+ * - `void on_message(epoll_connection& conn, frame_type type, sl::io::span<const char> payload)`
+ * - `void on_close(epoll_connection& conn, uint16_t code)`
+ *
+ * Message payload is valid only during the `on_message` call.
+ * This header is available only on Linux and is not included into `staticlib/websocket.hpp`.
+ *
+ * @tparam Handler handler type
+ */
+template<typename Handler>
+class epoll_server {
+    epoll_server_config config;
+    Handler& handler;
+    std::atomic<uint64_t> id_counter;
+    uint16_t actual_port = 0;
+    std::vector<std::unique_ptr<detail_epoll::event_loop<Handler>>> loops;
+    std::vector<std::thread> threads;
+
+public:
+    /**
+     * Constructor, server is not started until `start()` is called
+     *
+     * @param conf server config
+     * @param handler handler, must remain valid while server is running
+     */
+    epoll_server(const epoll_server_config& conf, Handler& handler) :
+    config(conf),
+    handler(handler),
+    id_counter(1) {
+        if (0 == config.threads) {
+            auto hc = std::thread::hardware_concurrency();
+            config.threads = hc > 0 ? hc : 1;
+        }
+    }
+
+    /**
+     * Destructor, stops the server
+     */
+    ~epoll_server() STATICLIB_NOEXCEPT {
+        stop();
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    epoll_server(const epoll_server&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    epoll_server& operator=(const epoll_server&) = delete;
+
+    /**
+     * Opens listening sockets and starts event loop threads
+     *
+     * @throws websocket_exception on socket setup error
+     */
+    void start() {
+        if (!loops.empty()) {
+            throw websocket_exception(TRACEMSG("Server is already started"));
+        }
+        try {
+            for (size_t i = 0; i < config.threads; i++) {
+                // all shards must bind to the same port, first one can use ephemeral port
+                int fd = detail_epoll::open_listener(config, 0 == i ? config.port : actual_port);
+                if (0 == i) {
+                    this->actual_port = detail_epoll::bound_port(fd);
+                }
+                try {
+                    loops.emplace_back(new detail_epoll::event_loop<Handler>(config, handler, id_counter, fd));
+                } catch (...) {
+                    ::close(fd);
+                    throw;
+                }
+            }
+        } catch (...) {
+            loops.clear();
+            throw;
+        }
+        // hardware_concurrency may be unknown, then thread count is used
+        auto hc = std::thread::hardware_concurrency();
+        size_t cpus_count = hc > 0 ? hc : config.threads;
+        for (size_t i = 0; i < loops.size(); i++) {
+            auto loop = loops[i].get();
+            threads.emplace_back([loop] {
+                loop->run();
+            });
+            if (config.pin_threads) {
+                cpu_set_t cpus;
+                CPU_ZERO(std::addressof(cpus));
+                CPU_SET(i % cpus_count, std::addressof(cpus));
+                ::pthread_setaffinity_np(threads.back().native_handle(), sizeof(cpus), std::addressof(cpus));
+            }
+        }
+    }
+
+    /**
+     * Stops event loops and waits for their threads to exit,
+     * open connections are dropped with `on_close` called
+     * with `close_going_away` status
+     */
+    void stop() {
+        for (auto& loop : loops) {
+            loop->stop();
+        }
+        for (auto& th : threads) {
+            if (th.joinable()) {
+                th.join();
+            }
+        }
+        threads.clear();
+        loops.clear();
+    }
+
+    /**
+     * Port the server is listening on
+     *
+     * @return port, `0` if server is not started
+     */
+    uint16_t port() const {
+        return actual_port;
+    }
+
+    /**
+     * Number of event loops
+     *
+     * @return number of loops
+     */
+    size_t loops_count() const {
+        return config.threads;
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_EPOLL_SERVER_HPP */
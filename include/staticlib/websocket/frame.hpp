@@ -26,14 +26,19 @@
 
 #include <cstdint>
 #include <array>
-#include <limits>
 
 #include "staticlib/support.hpp"
 #include "staticlib/endian.hpp"
 #include "staticlib/io.hpp"
 
+#include "staticlib/websocket/frame_header.hpp"
 #include "staticlib/websocket/frame_type.hpp"
 #include "staticlib/websocket/masked_payload_source.hpp"
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/role.hpp"
+#include "staticlib/websocket/stats.hpp"
+#include "staticlib/websocket/utf8_validator.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
 
 namespace staticlib {
 namespace websocket {
@@ -90,6 +95,11 @@ class frame {
      * Flag shows whether `final` bit is set in frame
      */
     bool final = false;
+    /**
+     * Values of RSV1, RSV2 and RSV3 bits (in this order from
+     * the most significant one)
+     */
+    uint8_t rsv = 0;
     /**
      * Frame type
      */
@@ -104,9 +114,9 @@ class frame {
      */
     uint8_t ex_payload_len_field_size = 0;
     /**
-     * Payload length
+     * Payload length, 63-bit value
      */
-    uint32_t payload_len = 0;
+    uint64_t payload_len = 0;
     /**
      * Flag shows whether this frame is masked (came from client)
      */
@@ -115,6 +125,11 @@ class frame {
      * Mask value
      */
     uint32_t mask = 0;
+    /**
+     * Flag shows whether the payload was already unmasked
+     * in the underlying buffer
+     */
+    bool unmasked = false;
 
     /**
      * Size of the mandatory frame header
@@ -131,14 +146,14 @@ public:
      */
     frame(sl::io::span<const char> data_view) :
     view(data_view) {
-        check_min_len();
-        parse_final();
-        parse_opcode();
-        parse_payload_7();
-        parse_payload_16();
-        parse_payload_64();
-        parse_mask();
-        check_complete();
+        // fast path for complete headers, step-by-step parsing
+        // is used to get the partial state of incomplete or invalid ones
+        auto head = frame_header();
+        if (header_status::complete == frame_header::parse(view, head)) {
+            init_from_header(head);
+        } else {
+            parse_partial();
+        }
     }
 
     /**
@@ -162,6 +177,21 @@ public:
         return complete;
     }
 
+    /**
+     * Checks the frame against the rules for the specified role
+     * (see `server_role`, `client_role`): masking direction,
+     * RSV bits and control frames limits
+     * 
+     * @param allowed_rsv RSV bits allowed by the negotiated extensions
+     * @return `true` if frame is well-formed and conforms to the rules
+     */
+    template<typename Role>
+    bool conforms_to(uint8_t allowed_rsv = 0) {
+        return well_formed && view.size() >= prefix_len &&
+                detail_role::check_prefix<Role>(static_cast<uint8_t>(view[0]),
+                        static_cast<uint8_t>(view[1]), allowed_rsv);
+    }
+
     /**
      * Flag shows whether `final` bit is set in frame
      * 
@@ -171,6 +201,26 @@ public:
         return final;
     }
 
+    /**
+     * Values of RSV1, RSV2 and RSV3 bits, RSV1 is the most
+     * significant bit of the returned value
+     * 
+     * @return RSV bits value (`0` - `7`)
+     */
+    uint8_t rsv_bits() {
+        return rsv;
+    }
+
+    /**
+     * Flag shows whether RSV1 bit is set in frame, with
+     * "permessage-deflate" extension it marks compressed messages
+     * 
+     * @return whether RSV1 bit is set in frame
+     */
+    bool is_compressed() {
+        return 0 != (rsv & 0x04);
+    }
+
     /**
      * Frame type (opcode)
      * 
@@ -189,6 +239,16 @@ public:
         return masked;
     }
 
+    /**
+     * Flag shows whether the payload of this frame was already
+     * unmasked in place in the underlying buffer
+     * 
+     * @return `true` if payload was unmasked in place, `false` otherwise
+     */
+    bool is_unmasked() {
+        return unmasked;
+    }
+
     /**
      * Pointer to the underlying buffer
      * 
@@ -203,8 +263,8 @@ public:
      * 
      * @return frame size for complete frames, zero for incomplete ones
      */
-    uint32_t size() {
-        return static_cast<uint32_t>(complete ? payload_pos() + payload_len : 0);
+    uint64_t size() {
+        return complete ? payload_pos() + payload_len : 0;
     }
 
     /**
@@ -221,10 +281,38 @@ public:
      * 
      * @return payload length in bytes
      */
-    uint32_t payload_length() {
+    uint64_t payload_length() {
         return payload_len;
     }
 
+    /**
+     * Flag shows whether all header fields (including extended
+     * length and masking key) are available in the buffer
+     * 
+     * @return whether the header is complete
+     */
+    bool is_header_complete() {
+        return well_formed && parsing && view.size() >= payload_pos();
+    }
+
+    /**
+     * Span that points to the part of the (possibly masked) payload
+     * that is available in the buffer, can be used with incomplete frames
+     * to process large payloads in windows as they arrive
+     * (see also `frame_parser::feed_in_place`)
+     * 
+     * @return span pointing to the available payload bytes,
+     *         empty span if header is not complete
+     */
+    sl::io::span<const char> payload_available() {
+        if (!is_header_complete()) {
+            return sl::io::span<const char>(nullptr, 0);
+        }
+        uint64_t avail = view.size() - payload_pos();
+        auto len = avail < payload_len ? avail : payload_len;
+        return sl::io::make_span(view.data() + payload_pos(), static_cast<size_t>(len));
+    }
+
     /**
      * Span that points to the header, for incomplete
      * frames - points to the part of the header
@@ -256,7 +344,7 @@ public:
      */
     sl::io::span<const char> payload() {
         if(well_formed && complete) {
-            return sl::io::make_span(view.data() + payload_pos(), payload_len);
+            return sl::io::make_span(view.data() + payload_pos(), static_cast<size_t>(payload_len));
         } else {
             return sl::io::span<const char>(nullptr, 0);
         }
@@ -269,45 +357,166 @@ public:
      */
     masked_payload_source payload_unmasked() {
         auto span = complete ?
-            sl::io::make_span(view.data() + payload_pos(), payload_len) :
+            sl::io::make_span(view.data() + payload_pos(), static_cast<size_t>(payload_len)) :
             sl::io::span<const char>(nullptr, 0);
-        return masked_payload_source(span, mask);
+        return masked_payload_source(span, unmasked ? 0 : mask);
     }
 
     /**
-     * Creates a frame header and writes it into the specified buffer
+     * Fused decoding of text payload: reads masked payload, writes cleartext
+     * into dest buffer and updates UTF-8 validator - all in a single pass
+     * over the payload
+     * 
+     * @param dest dest buffer, must be at least `payload_length()` bytes
+     * @param validator validator that keeps the state between frames of the message,
+     *        validation result is available from it after this call
+     * @return span pointing to the cleartext payload in dest buffer,
+     *         empty span for incomplete frames
+     */
+    sl::io::span<char> decode_payload(sl::io::span<char> dest, utf8_validator& validator) {
+        if (!(well_formed && complete)) {
+            return sl::io::span<char>(nullptr, 0);
+        }
+        if (dest.size() < payload_len) {
+            throw websocket_exception(TRACEMSG("Insufficient buffer specified for payload decoding,"
+                    " payload length: [" + sl::support::to_string(payload_len) + "]," +
+                    " buffer size: [" + sl::support::to_string(dest.size()) + "]"));
+        }
+        auto len = static_cast<size_t>(payload_len);
+        unmask_and_validate(view.data() + payload_pos(), dest.data(), len,
+                unmasked ? 0 : mask, 0, validator);
+        if (masked && !unmasked) {
+            stats::increment(stats::counter::bytes_unmasked, len);
+        }
+        return sl::io::make_span(dest.data(), len);
+    }
+
+    /**
+     * Unmasks the payload inside the underlying buffer, specified
+     * buffer must be a writable view of the same memory this frame
+     * was created from. Payload is unmasked only once, subsequent calls
+     * (and `payload_unmasked()`) return the payload as is.
+     * 
+     * @param buffer writable span pointing to the same buffer as this frame
+     * @return span pointing to the cleartext payload, empty span for incomplete frames
+     */
+    sl::io::span<char> unmask_in_place(sl::io::span<char> buffer) {
+        if (!(well_formed && complete)) {
+            return sl::io::span<char>(nullptr, 0);
+        }
+        if (buffer.data() != view.data() || buffer.size() < size()) {
+            throw websocket_exception(TRACEMSG("Invalid buffer specified for in-place unmasking,"
+                    " frame size: [" + sl::support::to_string(size()) + "]," +
+                    " buffer size: [" + sl::support::to_string(buffer.size()) + "]"));
+        }
+        auto pl = sl::io::make_span(buffer.data() + payload_pos(), static_cast<size_t>(payload_len));
+        if (masked && !unmasked) {
+            apply_mask(pl.data(), pl.data(), pl.size(), mask);
+            this->unmasked = true;
+            stats::increment(stats::counter::bytes_unmasked, pl.size());
+        }
+        return pl;
+    }
+
+    /**
+     * Creates a frame header and writes it into the specified buffer,
+     * masking key is NOT written by this method, use the overload that
+     * takes the mask value to create masked headers
      * 
      * @param buf dest buffer
      * @param fr_type frame type
-     * @param pl_len length of the payload that will be sent with this frame
+     * @param pl_len length of the payload that will be sent with this frame,
+     *        must be less than 2^63
      * @param masked whether payload will be masked
      * @param partial whether the `final` bit needs to be set to `0`
+     * @param compressed whether RSV1 ("permessage-deflate" compressed) bit needs to be set
+     * @return header span that points to dest buffer
+     */
+    static sl::io::span<char> make_header(std::array<char, 10>& buf, frame_type fr_type, uint64_t pl_len,
+            bool masked = false, bool partial = false, bool compressed = false) {
+        auto len = write_header(buf.data(), fr_type, pl_len, masked, partial, compressed);
+        return sl::io::make_span(buf.data(), len);
+    }
+
+    /**
+     * Creates a masked frame header (including the masking key) and writes
+     * it into the specified buffer. Payload should be masked with the same key,
+     * see `masked_payload_sink`.
+     * 
+     * @param buf dest buffer
+     * @param fr_type frame type
+     * @param pl_len length of the payload that will be sent with this frame,
+     *        must be less than 2^63
+     * @param mask_val masking key, must not be zero
+     * @param partial whether the `final` bit needs to be set to `0`
+     * @param compressed whether RSV1 ("permessage-deflate" compressed) bit needs to be set
      * @return header span that points to dest buffer
      */
-    static sl::io::span<char> make_header(std::array<char, 10>& buf, frame_type fr_type, size_t pl_len,
-            bool masked = false, bool partial = false) {
+    static sl::io::span<char> make_header(std::array<char, 14>& buf, frame_type fr_type, uint64_t pl_len,
+            uint32_t mask_val, bool partial = false, bool compressed = false) {
+        auto len = write_header(buf.data(), fr_type, pl_len, true, partial, compressed);
+        buf[len] = static_cast<char>((mask_val >> 24) & 0xff);
+        buf[len + 1] = static_cast<char>((mask_val >> 16) & 0xff);
+        buf[len + 2] = static_cast<char>((mask_val >> 8) & 0xff);
+        buf[len + 3] = static_cast<char>(mask_val & 0xff);
+        return sl::io::make_span(buf.data(), len + 4);
+    }
+
+private:
+
+    static size_t write_header(char* buf, frame_type fr_type, uint64_t pl_len,
+            bool masked, bool partial, bool compressed) {
+        if (0 != (pl_len >> 63)) {
+            throw websocket_exception(TRACEMSG("Invalid payload length specified,"
+                    " length: [" + sl::support::to_string(pl_len) + "]"));
+        }
         uint8_t mask_byte = !masked ? 0 : (1<<7);
-        buf[0] = (!partial ? (1<<7) : 0) | static_cast<uint8_t>(fr_type);
+        buf[0] = (!partial ? (1<<7) : 0) | (compressed ? (1<<6) : 0) | static_cast<uint8_t>(fr_type);
         if (pl_len < (1<<7) - 2) {
             buf[1] = static_cast<char>(mask_byte | pl_len);
-            return sl::io::make_span(buf.data(), 2);
+            return 2;
         } else {
-            auto sink = sl::io::memory_sink({buf.data() + 2, buf.size() - 2});
+            auto sink = sl::io::memory_sink({buf + 2, 8});
             if(pl_len < (1<<16)) {
                 auto val = mask_byte | ((1<<7) - 2);
                 buf[1] = static_cast<uint8_t>(val);
-                sl::endian::write_16_be(sink, pl_len);
-                return sl::io::make_span(buf.data(), 4);
+                sl::endian::write_16_be(sink, static_cast<uint16_t>(pl_len));
+                return 4;
             } else {
                 auto val = mask_byte | ((1<<7) - 1);
                 buf[1] = static_cast<uint8_t>(val);
                 sl::endian::write_64_be(sink, pl_len);
-                return sl::io::make_span(buf.data(), buf.size());
+                return 10;
             }
         }
     }
 
-private:
+    void parse_partial() {
+        check_min_len();
+        parse_final();
+        parse_rsv();
+        parse_opcode();
+        parse_payload_7();
+        parse_payload_16();
+        parse_payload_64();
+        parse_mask();
+        check_complete();
+        record_stats();
+    }
+
+    void init_from_header(const frame_header& head) {
+        this->final = head.is_final();
+        this->rsv = head.rsv_bits();
+        this->ftype = head.type();
+        this->payload_len_7 = view[1] & 0x7F;
+        this->payload_len = head.payload_length();
+        this->masked = head.is_masked();
+        this->mask = head.mask_value();
+        this->ex_payload_len_field_size = static_cast<uint8_t>(head.header_length() - prefix_len - mask_length());
+        // header is complete, payload check does not need to recompute its position
+        this->complete = view.size() - head.header_length() >= payload_len;
+        stats::frame_decoded(ftype);
+    }
 
     void check_min_len() {
         if (view.size() < prefix_len) {
@@ -321,6 +530,12 @@ private:
         }
     }
 
+    void parse_rsv() {
+        if (parsing) {
+            this->rsv = static_cast<uint8_t>((view[0] >> 4) & 0x07);
+        }
+    }
+
     void parse_opcode() {
         if (parsing) {
             uint8_t opcode = view[0] & 0x0F;
@@ -330,6 +545,7 @@ private:
             } else {
                 this->parsing = false;
                 this->well_formed = false;
+                stats::increment(stats::counter::rejected_opcode);
             }
         }
     }
@@ -347,7 +563,7 @@ private:
         if (parsing && 126 == payload_len_7) {
             if (view.size() >= 4) {
                 auto src = sl::io::array_source(view.data() + prefix_len, 2);
-                this->payload_len = sl::endian::read_16_be<uint32_t>(src);
+                this->payload_len = sl::endian::read_16_be<uint16_t>(src);
                 this->ex_payload_len_field_size = 2;
             } else {
                 this->parsing = false;
@@ -360,13 +576,14 @@ private:
             if (view.size() >= 10) {
                 auto src = sl::io::array_source(view.data() + prefix_len, 8);
                 auto p64 = sl::endian::read_64_be<uint64_t>(src);
-                if (p64 < std::numeric_limits<int32_t>::max() -
-                        (prefix_len + 8 + sizeof(mask))) {
-                    this->payload_len = static_cast<uint32_t>(p64);
+                // the most significant bit must be 0, RFC 6455 5.2
+                if (0 == (p64 >> 63)) {
+                    this->payload_len = p64;
                     this->ex_payload_len_field_size = 8;
                 } else {
                     this->parsing = false;
                     this->well_formed = false;
+                    stats::increment(stats::counter::rejected_length);
                 }
             } else {
                 this->parsing = false;
@@ -385,17 +602,26 @@ private:
                 } else {
                     this->parsing = false;
                     this->well_formed = false;
+                    stats::increment(stats::counter::rejected_zero_mask);
                 }
             }
         }
     }
 
     void check_complete() {
-        if (parsing && view.size() >= prefix_len + ex_payload_len_field_size + mask_length() + payload_len) {
+        if (parsing && view.size() >= payload_pos() && view.size() - payload_pos() >= payload_len) {
             this->complete = true;
         }
     }
 
+    void record_stats() {
+        if (is_header_complete()) {
+            stats::frame_decoded(ftype);
+        } else if (well_formed) {
+            stats::increment(stats::counter::headers_incomplete);
+        }
+    }
+
     uint8_t mask_length() {
         return static_cast<uint8_t>(masked ? 4 : 0);
     }
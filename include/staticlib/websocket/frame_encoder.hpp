@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   frame_encoder.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_FRAME_ENCODER_HPP
+#define STATICLIB_WEBSOCKET_FRAME_ENCODER_HPP
+
+#include <cstdint>
+#include <array>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/role.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_encoder {
+
+inline void check_frame(frame_type fr_type, uint64_t pl_len, bool final, bool compressed) {
+    bool control = 0 != (static_cast<uint8_t>(fr_type) & 0x08);
+    if (control && (pl_len > 125 || !final || compressed)) {
+        throw websocket_exception(TRACEMSG("Invalid control frame parameters specified,"
+                " type: [" + sl::support::to_string(static_cast<int>(fr_type)) + "]," +
+                " payload length: [" + sl::support::to_string(pl_len) + "]," +
+                " final: [" + sl::support::to_string(final) + "]," +
+                " compressed: [" + sl::support::to_string(compressed) + "]"));
+    }
+    if (compressed && frame_type::continuation == fr_type) {
+        throw websocket_exception(TRACEMSG("RSV1 bit cannot be set on continuation frames"));
+    }
+    if (frame_type::invalid == fr_type) {
+        throw websocket_exception(TRACEMSG("Invalid frame type specified"));
+    }
+}
+
+} // namespace
+
+/**
+ * Role-specific frame header encoder, enforces RFC 6455 rules:
+ * masking direction is fixed by the role, control frames must be final,
+ * not compressed and not longer than 125 bytes.
+ * Only specializations for `server_role` and `client_role` are defined.
+ *
+ * @tparam Role role policy
+ */
+template<typename Role>
+class frame_encoder;
+
+/**
+ * Server-side encoder, creates unmasked headers
+ */
+template<>
+class frame_encoder<server_role> {
+public:
+    /**
+     * Creates an unmasked frame header
+     *
+     * @param buf dest buffer
+     * @param fr_type frame type
+     * @param pl_len length of the payload that will be sent with this frame
+     * @param final whether the `final` bit needs to be set
+     * @param compressed whether RSV1 bit needs to be set
+     * @return header span that points to dest buffer
+     * @throws websocket_exception if parameters violate the protocol
+     */
+    static sl::io::span<char> make_header(std::array<char, 10>& buf, frame_type fr_type, uint64_t pl_len,
+            bool final = true, bool compressed = false) {
+        detail_encoder::check_frame(fr_type, pl_len, final, compressed);
+        return frame::make_header(buf, fr_type, pl_len, false, !final, compressed);
+    }
+};
+
+/**
+ * Client-side encoder, creates masked headers
+ */
+template<>
+class frame_encoder<client_role> {
+public:
+    /**
+     * Creates a masked frame header, payload must be masked
+     * with the same key, see `masked_payload_sink`
+     *
+     * @param buf dest buffer
+     * @param fr_type frame type
+     * @param pl_len length of the payload that will be sent with this frame
+     * @param mask_val masking key, must not be zero, for example
+     *        `next_mask_key()` from `staticlib/websocket/mask_keys.hpp`
+     * @param final whether the `final` bit needs to be set
+     * @param compressed whether RSV1 bit needs to be set
+     * @return header span that points to dest buffer
+     * @throws websocket_exception if parameters violate the protocol
+     */
+    static sl::io::span<char> make_header(std::array<char, 14>& buf, frame_type fr_type, uint64_t pl_len,
+            uint32_t mask_val, bool final = true, bool compressed = false) {
+        detail_encoder::check_frame(fr_type, pl_len, final, compressed);
+        if (0 == mask_val) {
+            throw websocket_exception(TRACEMSG("Invalid zero masking key specified"));
+        }
+        return frame::make_header(buf, fr_type, pl_len, mask_val, !final, compressed);
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_FRAME_ENCODER_HPP */
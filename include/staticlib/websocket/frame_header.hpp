@@ -0,0 +1,369 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   frame_header.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_FRAME_HEADER_HPP
+#define STATICLIB_WEBSOCKET_FRAME_HEADER_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include "staticlib/config.hpp"
+
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif // _MSC_VER
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/role.hpp"
+#include "staticlib/websocket/stats.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Result of the header decoding
+ */
+enum class header_status {
+    /**
+     * Header is decoded successfully
+     */
+    complete,
+    /**
+     * More bytes are needed to decode the header
+     */
+    incomplete,
+    /**
+     * Header is invalid (corrupted)
+     */
+    malformed
+};
+
+class frame;
+
+namespace detail_header {
+
+/**
+ * Header length (low 4 bits) and the size of the extended
+ * payload length field (high 4 bits: 0, 2 or 8) keyed on the
+ * second header byte (MASK bit and 7-bit payload length)
+ */
+constexpr uint8_t length_info[256] = {
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x24, 0x8a,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x28, 0x8e
+};
+
+/**
+ * Bit set of valid opcodes: continuation, text, binary, close, ping, pong
+ */
+const uint16_t valid_opcodes = 0x0707;
+
+inline uint16_t load_be16(const char* data) {
+    uint16_t res;
+    std::memcpy(&res, data, sizeof(res));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return res;
+#elif defined(__GNUC__)
+    return __builtin_bswap16(res);
+#elif defined(_MSC_VER)
+    return _byteswap_ushort(res);
+#else
+    return static_cast<uint16_t>((static_cast<uint8_t>(data[0]) << 8) | static_cast<uint8_t>(data[1]));
+#endif
+}
+
+inline uint32_t load_be32(const char* data) {
+    uint32_t res;
+    std::memcpy(&res, data, sizeof(res));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return res;
+#elif defined(__GNUC__)
+    return __builtin_bswap32(res);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(res);
+#else
+    return (static_cast<uint32_t>(load_be16(data)) << 16) | load_be16(data + 2);
+#endif
+}
+
+inline uint64_t load_be64(const char* data) {
+    uint64_t res;
+    std::memcpy(&res, data, sizeof(res));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return res;
+#elif defined(__GNUC__)
+    return __builtin_bswap64(res);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(res);
+#else
+    return (static_cast<uint64_t>(load_be32(data)) << 32) | load_be32(data + 4);
+#endif
+}
+
+} // namespace
+
+/**
+ * Compact (trivially copyable) record with decoded frame header fields,
+ * does not reference the frame buffer
+ */
+class frame_header {
+    friend class frame;
+
+    /**
+     * Payload length
+     */
+    uint64_t payload_len;
+    /**
+     * Mask value, zero for unmasked frames
+     */
+    uint32_t mask;
+    /**
+     * First header byte as is: `final` bit, RSV bits and opcode
+     */
+    uint8_t first_byte;
+    /**
+     * Header length including masking key
+     */
+    uint8_t header_len;
+    /**
+     * Flag shows whether this frame is masked
+     */
+    uint8_t masked;
+    /**
+     * Padding
+     */
+    uint8_t reserved;
+
+public:
+    /**
+     * Decodes frame header from the start of the specified buffer
+     * 
+     * @param data buffer that starts with a frame header
+     * @param out header record to write decoded fields into
+     * @return decoding status
+     */
+    static header_status decode(sl::io::span<const char> data, frame_header& out) {
+        auto res = parse(data, out);
+        if (header_status::complete == res) {
+            stats::frame_decoded(out.type());
+        } else {
+            record_failure(data, res);
+        }
+        return res;
+    }
+
+    /**
+     * Decodes frame header from the start of the specified buffer
+     * and checks it against the rules for the specified role
+     * (see `server_role`, `client_role`), frames violating these
+     * rules are reported as malformed
+     * 
+     * @param data buffer that starts with a frame header
+     * @param out header record to write decoded fields into
+     * @param allowed_rsv RSV bits allowed by the negotiated extensions
+     * @return decoding status
+     */
+    template<typename Role>
+    static header_status decode(sl::io::span<const char> data, frame_header& out, uint8_t allowed_rsv) {
+        if (data.size() >= 2 && !detail_role::check_prefix<Role>(static_cast<uint8_t>(data[0]),
+                static_cast<uint8_t>(data[1]), allowed_rsv)) {
+            stats::increment(stats::counter::rejected_role);
+            return header_status::malformed;
+        }
+        return decode(data, out);
+    }
+
+    /**
+     * Flag shows whether `final` bit is set in frame
+     * 
+     * @return whether `final` bit is set in frame
+     */
+    bool is_final() const {
+        return 0 != (first_byte & 0x80);
+    }
+
+    /**
+     * Values of RSV1, RSV2 and RSV3 bits, RSV1 is the most
+     * significant bit of the returned value
+     * 
+     * @return RSV bits value (`0` - `7`)
+     */
+    uint8_t rsv_bits() const {
+        return static_cast<uint8_t>((first_byte >> 4) & 0x07);
+    }
+
+    /**
+     * Flag shows whether RSV1 bit is set in frame, with
+     * "permessage-deflate" extension it marks compressed messages
+     * 
+     * @return whether RSV1 bit is set in frame
+     */
+    bool is_compressed() const {
+        return 0 != (first_byte & 0x40);
+    }
+
+    /**
+     * Frame type (opcode)
+     * 
+     * @return opcode
+     */
+    frame_type type() const {
+        return make_frame_type(first_byte & 0x0F);
+    }
+
+    /**
+     * Flag shows whether this frame is masked (came from client)
+     * 
+     * @return `true`if masked, `false` otherwise
+     */
+    bool is_masked() const {
+        return 0 != masked;
+    }
+
+    /**
+     * Mask value
+     * 
+     * @return mask value
+     */
+    uint32_t mask_value() const {
+        return mask;
+    }
+
+    /**
+     * Payload length in bytes
+     * 
+     * @return payload length in bytes
+     */
+    uint64_t payload_length() const {
+        return payload_len;
+    }
+
+    /**
+     * Header length in bytes (including masking key)
+     * 
+     * @return header length in bytes
+     */
+    size_t header_length() const {
+        return header_len;
+    }
+
+    /**
+     * Size of the frame (header + payload)
+     * 
+     * @return frame size
+     */
+    uint64_t size() const {
+        return header_len + payload_len;
+    }
+
+private:
+    /**
+     * Table-driven decoding without per-field checks: header layout
+     * is taken from the table, length fields and masking key are read
+     * with direct big-endian loads, all validity checks are combined
+     * into a single branch; does not update stats.
+     *
+     * Table value selects the decoder instead of being used in the length
+     * arithmetic, so inside each decoder the header length is a compile-time
+     * constant; short layouts are checked first and are small enough to be
+     * inlined into the caller.
+     */
+    static header_status parse(sl::io::span<const char> data, frame_header& out) {
+        if (data.size() < 2) {
+            return header_status::incomplete;
+        }
+        switch (detail_header::length_info[static_cast<uint8_t>(data[1])]) {
+        case 0x06: return parse_layout<0, true>(data, out);
+        case 0x02: return parse_layout<0, false>(data, out);
+        default: return parse_extended(data, out);
+        }
+    }
+
+    static header_status parse_extended(sl::io::span<const char> data, frame_header& out) {
+        switch (detail_header::length_info[static_cast<uint8_t>(data[1])]) {
+        case 0x24: return parse_layout<2, false>(data, out);
+        case 0x8a: return parse_layout<8, false>(data, out);
+        case 0x28: return parse_layout<2, true>(data, out);
+        default: return parse_layout<8, true>(data, out);
+        }
+    }
+
+    template<uint8_t ExLen, bool Masked>
+    static header_status parse_layout(sl::io::span<const char> data, frame_header& out) {
+        const uint8_t hlen = 2 + ExLen + (Masked ? 4 : 0);
+        auto b0 = static_cast<uint8_t>(data[0]);
+        bool opcode_valid = 0 != ((detail_header::valid_opcodes >> (b0 & 0x0F)) & 1);
+        if (data.size() < hlen) {
+            return opcode_valid ? header_status::incomplete : header_status::malformed;
+        }
+        const char* ex = data.data() + 2;
+        uint64_t plen = 2 == ExLen ? detail_header::load_be16(ex) :
+                8 == ExLen ? detail_header::load_be64(ex) :
+                static_cast<uint8_t>(data[1]) & 0x7F;
+        uint32_t mask_val = Masked ? detail_header::load_be32(ex + ExLen) : 0;
+        // the most significant bit of the length must be 0, RFC 6455 5.2
+        bool invalid = !opcode_valid | (0 != (plen >> 63)) | (Masked && 0 == mask_val);
+        if (invalid) {
+            return header_status::malformed;
+        }
+        out.payload_len = plen;
+        out.mask = mask_val;
+        out.first_byte = b0;
+        out.header_len = hlen;
+        out.masked = Masked ? 1 : 0;
+        out.reserved = 0;
+        return header_status::complete;
+    }
+
+    static void record_failure(sl::io::span<const char> data, header_status status) {
+        if (header_status::incomplete == status) {
+            stats::increment(stats::counter::headers_incomplete);
+        } else if (frame_type::invalid == make_frame_type(static_cast<uint8_t>(data[0]) & 0x0F)) {
+            stats::increment(stats::counter::rejected_opcode);
+        } else if (127 == (static_cast<uint8_t>(data[1]) & 0x7F) && 0 != (static_cast<uint8_t>(data[2]) & 0x80)) {
+            stats::increment(stats::counter::rejected_length);
+        } else {
+            stats::increment(stats::counter::rejected_zero_mask);
+        }
+    }
+
+};
+
+static_assert(16 == sizeof(frame_header), "Invalid frame header record size");
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_FRAME_HEADER_HPP */
@@ -0,0 +1,423 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   frame_parser.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_FRAME_PARSER_HPP
+#define STATICLIB_WEBSOCKET_FRAME_PARSER_HPP
+
+#include <cstdint>
+#include <array>
+#include <cstring>
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame_header.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/masked_payload_sink.hpp"
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/role.hpp"
+#include "staticlib/websocket/stats.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Incremental (resumable) WebSocket frame parser. Input is fed
+ * in arbitrary chunks, decoded header fields are kept between calls,
+ * so bytes are never parsed twice. Payload is unmasked and streamed
+ * into the specified sink as soon as it arrives.
+ * 
+ * Role policy (`server_role`, `client_role`) enables RFC 6455 checks
+ * for the masking direction, RSV bits and control frames, that are done
+ * on the first two header bytes; with `any_role` these checks are compiled out.
+ * 
+ * Parser handles a single frame, `reset()` must be called after
+ * the frame is complete to parse the next one.
+ * 
+ * @tparam Role role policy
+ */
+template<typename Role>
+class basic_frame_parser {
+    /**
+     * Parsing state
+     */
+    enum class parser_state {
+        header, payload, complete, failed
+    };
+
+    /**
+     * Current state
+     */
+    parser_state state = parser_state::header;
+    /**
+     * Header bytes collected so far
+     */
+    std::array<char, 14> header_buf;
+    /**
+     * Number of header bytes collected so far
+     */
+    uint8_t header_filled = 0;
+    /**
+     * Header length, only minimal prefix length is known
+     * until the second header byte is received
+     */
+    uint8_t header_len = prefix_len;
+
+    /**
+     * Flag shows whether `final` bit is set in frame
+     */
+    bool final = false;
+    /**
+     * Values of RSV1, RSV2 and RSV3 bits
+     */
+    uint8_t rsv = 0;
+    /**
+     * Frame type
+     */
+    frame_type ftype = frame_type::invalid;
+    /**
+     * Flag shows whether this frame is masked (came from client)
+     */
+    bool masked = false;
+    /**
+     * Mask value
+     */
+    uint32_t mask = 0;
+    /**
+     * Payload length, 63-bit value
+     */
+    uint64_t payload_len = 0;
+    /**
+     * Number of payload bytes streamed so far
+     */
+    uint64_t payload_read = 0;
+    /**
+     * RSV bits allowed by the negotiated extensions
+     */
+    uint8_t allowed_rsv;
+
+    /**
+     * Size of the mandatory frame header
+     */
+    static const uint8_t prefix_len = 2;
+
+public:
+    /**
+     * Constructor
+     * 
+     * @param allowed_rsv RSV bits allowed by the negotiated extensions
+     *        (RSV1 - `0x04` for "permessage-deflate"), not used with `any_role`
+     */
+    basic_frame_parser(uint8_t allowed_rsv = 0) :
+    allowed_rsv(allowed_rsv) { }
+
+    /**
+     * Feeds the next chunk of input into parser. Consumes header bytes and
+     * payload bytes of the current frame, the unmasked payload is written
+     * into the specified sink. Bytes after the end of the current frame are
+     * not consumed.
+     * 
+     * @param data input chunk
+     * @param payload_sink sink to write unmasked payload into
+     * @return number of bytes consumed from the input chunk
+     */
+    template<typename Sink>
+    size_t feed(sl::io::span<const char> data, Sink& payload_sink) {
+        size_t consumed = 0;
+        if (parser_state::header == state) {
+            consumed += feed_header(data);
+        }
+        if (parser_state::payload == state && consumed < data.size()) {
+            auto len = payload_chunk_length(data.size() - consumed);
+            auto chunk = sl::io::make_span(data.data() + consumed, len);
+            if (masked) {
+                auto unmasker = masked_payload_sink<sl::io::reference_sink<Sink>>(
+                        sl::io::make_reference_sink(payload_sink), mask,
+                        static_cast<size_t>(payload_read & 3));
+                unmasker.write(chunk);
+                stats::increment(stats::counter::bytes_unmasked, len);
+            } else {
+                sl::io::write_all(payload_sink, chunk);
+            }
+            consumed += len;
+            advance_payload(len);
+        }
+        return consumed;
+    }
+
+    /**
+     * Zero-copy variant of `feed`, that does not buffer the payload: consumes
+     * header bytes and unmasks in place the payload bytes of the current frame,
+     * that are available in the (writable) input chunk. Allows to process
+     * arbitrary large payloads in windows as they arrive.
+     * 
+     * @param data input chunk, payload bytes are unmasked in this buffer
+     * @param window span to store the unmasked payload bytes found in this chunk
+     * @return number of bytes consumed from the input chunk
+     */
+    size_t feed_in_place(sl::io::span<char> data, sl::io::span<char>& window) {
+        size_t consumed = 0;
+        window = sl::io::span<char>(nullptr, 0);
+        if (parser_state::header == state) {
+            consumed += feed_header(data);
+        }
+        if (parser_state::payload == state && consumed < data.size()) {
+            auto len = payload_chunk_length(data.size() - consumed);
+            window = sl::io::make_span(data.data() + consumed, len);
+            if (masked) {
+                apply_mask(window.data(), window.data(), len, mask, static_cast<size_t>(payload_read & 3));
+                stats::increment(stats::counter::bytes_unmasked, len);
+            }
+            consumed += len;
+            advance_payload(len);
+        }
+        return consumed;
+    }
+
+    /**
+     * Exact number of bytes that is still required to complete the header
+     * (if the header is not yet complete) or to complete the payload.
+     * While only first header byte is received, returns the number of bytes
+     * needed to determine the header length.
+     * 
+     * @return number of bytes still needed, zero for complete or failed frames
+     */
+    uint64_t bytes_needed() {
+        switch (state) {
+        case parser_state::header: return header_len - header_filled;
+        case parser_state::payload: return payload_len - payload_read;
+        default: return 0;
+        }
+    }
+
+    /**
+     * Resets the parser to be used for the next frame
+     */
+    void reset() {
+        this->state = parser_state::header;
+        this->header_filled = 0;
+        this->header_len = prefix_len;
+        this->final = false;
+        this->rsv = 0;
+        this->ftype = frame_type::invalid;
+        this->masked = false;
+        this->mask = 0;
+        this->payload_len = 0;
+        this->payload_read = 0;
+    }
+
+    /**
+     * Flag shows whether the frame is invalid (corrupted),
+     * parser cannot be used after the failure
+     * 
+     * @return `true` if frame is valid, `false` otherwise
+     */
+    bool is_well_formed() {
+        return parser_state::failed != state;
+    }
+
+    /**
+     * Flag shows whether all header fields are decoded
+     * 
+     * @return whether the header is complete
+     */
+    bool is_header_complete() {
+        return parser_state::payload == state || parser_state::complete == state;
+    }
+
+    /**
+     * Flag shows whether the whole frame (including payload) was parsed
+     * 
+     * @return whether the frame is complete
+     */
+    bool is_complete() {
+        return parser_state::complete == state;
+    }
+
+    /**
+     * Flag shows whether `final` bit is set in frame
+     * 
+     * @return whether `final` bit is set in frame
+     */
+    bool is_final() {
+        return final;
+    }
+
+    /**
+     * Values of RSV1, RSV2 and RSV3 bits, RSV1 is the most
+     * significant bit of the returned value
+     * 
+     * @return RSV bits value (`0` - `7`)
+     */
+    uint8_t rsv_bits() {
+        return rsv;
+    }
+
+    /**
+     * Flag shows whether RSV1 bit is set in frame, with
+     * "permessage-deflate" extension it marks compressed messages
+     * 
+     * @return whether RSV1 bit is set in frame
+     */
+    bool is_compressed() {
+        return 0 != (rsv & 0x04);
+    }
+
+    /**
+     * Frame type (opcode)
+     * 
+     * @return opcode
+     */
+    frame_type type() {
+        return ftype;
+    }
+
+    /**
+     * Flag shows whether this frame is masked (came from client)
+     * 
+     * @return `true`if masked, `false` otherwise
+     */
+    bool is_masked() {
+        return masked;
+    }
+
+    /**
+     * Mask value
+     * 
+     * @return mask value
+     */
+    uint32_t mask_value() {
+        return mask;
+    }
+
+    /**
+     * Payload length in bytes, only valid when header is complete
+     * 
+     * @return payload length in bytes
+     */
+    uint64_t payload_length() {
+        return payload_len;
+    }
+
+    /**
+     * Number of payload bytes already written to sink
+     * 
+     * @return number of payload bytes already streamed
+     */
+    uint64_t payload_bytes_read() {
+        return payload_read;
+    }
+
+    /**
+     * Span that points to the collected header bytes
+     * 
+     * @return span that points to the header
+     */
+    sl::io::span<const char> header() {
+        return sl::io::make_span(header_buf.data(), header_filled);
+    }
+
+private:
+    size_t payload_chunk_length(size_t avail) {
+        uint64_t rem = payload_len - payload_read;
+        return static_cast<size_t>(avail < rem ? avail : rem);
+    }
+
+    void advance_payload(size_t len) {
+        this->payload_read += len;
+        if (payload_read == payload_len) {
+            this->state = parser_state::complete;
+        }
+    }
+
+    size_t feed_header(sl::io::span<const char> data) {
+        size_t consumed = 0;
+        while (parser_state::header == state && consumed < data.size()) {
+            auto avail = data.size() - consumed;
+            auto need = static_cast<size_t>(header_len - header_filled);
+            auto len = avail < need ? avail : need;
+            std::memcpy(header_buf.data() + header_filled, data.data() + consumed, len);
+            consumed += len;
+            this->header_filled += static_cast<uint8_t>(len);
+            if (header_filled < header_len) {
+                stats::increment(stats::counter::headers_incomplete);
+                break;
+            }
+            if (prefix_len == header_filled) {
+                parse_prefix();
+            }
+            if (parser_state::header == state && header_filled == header_len) {
+                parse_ex_fields();
+            }
+        }
+        return consumed;
+    }
+
+    void parse_prefix() {
+        this->final = 1 == ((header_buf[0] >> 7) & 0x01);
+        this->rsv = static_cast<uint8_t>((header_buf[0] >> 4) & 0x07);
+        this->ftype = make_frame_type(header_buf[0] & 0x0F);
+        if (frame_type::invalid == ftype) {
+            this->state = parser_state::failed;
+            stats::increment(stats::counter::rejected_opcode);
+            return;
+        }
+        if (!detail_role::check_prefix<Role>(static_cast<uint8_t>(header_buf[0]),
+                static_cast<uint8_t>(header_buf[1]), allowed_rsv)) {
+            this->state = parser_state::failed;
+            stats::increment(stats::counter::rejected_role);
+            return;
+        }
+        this->masked = 1 == ((header_buf[1] >> 7) & 0x01);
+        this->header_len = detail_header::length_info[static_cast<uint8_t>(header_buf[1])] & 0x0F;
+    }
+
+    void parse_ex_fields() {
+        // whole header is buffered, decoding (and stats) is shared with frame_header
+        auto head = frame_header();
+        if (header_status::complete != frame_header::decode(header(), head)) {
+            this->state = parser_state::failed;
+            return;
+        }
+        this->payload_len = head.payload_length();
+        this->mask = head.mask_value();
+        this->state = payload_len > 0 ? parser_state::payload : parser_state::complete;
+    }
+
+};
+
+/**
+ * Role-agnostic frame parser
+ */
+typedef basic_frame_parser<any_role> frame_parser;
+
+/**
+ * Parser for the frames received by server
+ */
+typedef basic_frame_parser<server_role> server_frame_parser;
+
+/**
+ * Parser for the frames received by client
+ */
+typedef basic_frame_parser<client_role> client_frame_parser;
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_FRAME_PARSER_HPP */
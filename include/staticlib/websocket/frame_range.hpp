@@ -0,0 +1,295 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   frame_range.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_FRAME_RANGE_HPP
+#define STATICLIB_WEBSOCKET_FRAME_RANGE_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame_header.hpp"
+#include "staticlib/websocket/masked_payload_source.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Single-pass range over all complete frames in the buffer. Buffer
+ * is scanned once, each complete frame is yielded as a compact header
+ * record, trailing incomplete frame (if any) is available as a `remainder()`.
+ * Range doesn't own the underlying buffer.
+ */
+class frame_range {
+public:
+    /**
+     * Complete frame found in the buffer
+     */
+    class record {
+        frame_header head;
+        const char* data_ptr;
+
+    public:
+        /**
+         * Constructor
+         * 
+         * @param header decoded header
+         * @param data pointer to the start of the frame
+         */
+        record(const frame_header& header, const char* data) :
+        head(header),
+        data_ptr(data) { }
+
+        /**
+         * Decoded header fields
+         * 
+         * @return frame header
+         */
+        const frame_header& header() const {
+            return head;
+        }
+
+        /**
+         * Pointer to the start of the frame in the buffer
+         * 
+         * @return pointer to the start of the frame
+         */
+        const char* data() const {
+            return data_ptr;
+        }
+
+        /**
+         * Span that points to the (possibly masked) payload
+         * 
+         * @return payload span
+         */
+        sl::io::span<const char> payload() const {
+            return sl::io::make_span(data_ptr + head.header_length(),
+                    static_cast<size_t>(head.payload_length()));
+        }
+
+        /**
+         * Source, that allows to read the unmasked payload
+         * 
+         * @return unmasked payload source
+         */
+        masked_payload_source payload_unmasked() const {
+            return masked_payload_source(payload(), head.mask_value());
+        }
+    };
+
+    /**
+     * Input iterator over complete frames, advancing the iterator
+     * advances the range
+     */
+    class iterator {
+        frame_range* range;
+        record current;
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef record value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const record* pointer;
+        typedef const record& reference;
+
+        /**
+         * Constructor
+         * 
+         * @param fr_range range, `nullptr` for end iterator
+         */
+        iterator(frame_range* fr_range) :
+        range(fr_range),
+        current(frame_header(), nullptr) {
+            advance();
+        }
+
+        /**
+         * Current frame accessor
+         * 
+         * @return current frame
+         */
+        const record& operator*() const {
+            return current;
+        }
+
+        /**
+         * Current frame accessor
+         * 
+         * @return current frame
+         */
+        const record* operator->() const {
+            return std::addressof(current);
+        }
+
+        /**
+         * Moves to the next complete frame
+         * 
+         * @return this instance
+         */
+        iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        /**
+         * Equality operator
+         * 
+         * @param other other iterator
+         * @return whether both iterators are at the end of the range
+         */
+        bool operator==(const iterator& other) const {
+            return range == other.range;
+        }
+
+        /**
+         * Inequality operator
+         * 
+         * @param other other iterator
+         * @return whether iterators differ
+         */
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        void advance() {
+            if (nullptr != range && !range->next(current)) {
+                this->range = nullptr;
+            }
+        }
+    };
+
+private:
+    /**
+     * Span that points to the buffer
+     */
+    sl::io::span<const char> view;
+    /**
+     * Position of the next frame to scan
+     */
+    size_t pos = 0;
+    /**
+     * Flag shows whether invalid frame was found
+     */
+    bool well_formed = true;
+    /**
+     * Flag shows that scanning stopped at the trailing incomplete
+     * or invalid frame, `pos` points to the remainder
+     */
+    bool finished = false;
+
+public:
+    /**
+     * Constructor, takes a span that should point to a buffer
+     * containing zero or more frames. Buffer must remain valid
+     * during all the range use.
+     * 
+     * @param data_view span pointing to buffer with frames
+     */
+    frame_range(sl::io::span<const char> data_view) :
+    view(data_view) { }
+
+    /**
+     * Iterator pointing to the next complete frame
+     * 
+     * @return begin iterator
+     */
+    iterator begin() {
+        return iterator(this);
+    }
+
+    /**
+     * End iterator
+     * 
+     * @return end iterator
+     */
+    iterator end() {
+        return iterator(nullptr);
+    }
+
+    /**
+     * Finds the next complete frame in the buffer
+     * 
+     * @param out record to write found frame into
+     * @return `true` if complete frame was found, `false` at the end of the buffer
+     */
+    bool next(record& out) {
+        if (finished) {
+            return false;
+        }
+        auto head = frame_header();
+        auto rest = sl::io::make_span(view.data() + pos, view.size() - pos);
+        switch (frame_header::decode(rest, head)) {
+        case header_status::complete:
+            if (rest.size() >= head.size()) {
+                out = record(head, rest.data());
+                this->pos += static_cast<size_t>(head.size());
+                return true;
+            }
+            break;
+        case header_status::incomplete:
+            break;
+        default:
+            this->well_formed = false;
+        }
+        this->finished = true;
+        return false;
+    }
+
+    /**
+     * Trailing bytes that do not contain a complete frame,
+     * scans the rest of the buffer if iteration was not finished,
+     * trailing frame header is not decoded again after that
+     * 
+     * @return span pointing to the remaining bytes
+     */
+    sl::io::span<const char> remainder() {
+        auto rec = record(frame_header(), nullptr);
+        while (next(rec)) { }
+        return sl::io::make_span(view.data() + pos, view.size() - pos);
+    }
+
+    /**
+     * Flag shows whether invalid (corrupted) frame was found, remainder
+     * points to the start of the invalid frame in this case
+     * 
+     * @return `true` if no invalid frames were found, `false` otherwise
+     */
+    bool is_well_formed() {
+        return well_formed;
+    }
+
+    /**
+     * Number of bytes taken by complete frames found so far
+     * 
+     * @return number of bytes consumed
+     */
+    size_t consumed() {
+        return pos;
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_FRAME_RANGE_HPP */
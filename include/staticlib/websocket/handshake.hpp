@@ -24,18 +24,245 @@
 #ifndef STATICLIB_WEBSOCKET_HANDSHAKE_HPP
 #define STATICLIB_WEBSOCKET_HANDSHAKE_HPP
 
+#include <array>
+#include <cctype>
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <openssl/sha.h>
+
 #include "staticlib/crypto.hpp"
 #include "staticlib/io.hpp"
 #include "staticlib/support.hpp"
 
+#include "staticlib/websocket/deflate_params.hpp"
+#include "staticlib/websocket/stats.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
 namespace staticlib {
 namespace websocket {
 namespace handshake {
 
+/**
+ * Length of the `Sec-WebSocket-Accept` header value
+ */
+const size_t accept_key_length = 28;
+
+namespace detail_handshake {
+
+const char accept_guid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+const size_t accept_guid_length = sizeof(accept_guid) - 1;
+
+/**
+ * Valid keys are 24 chars long (base64 of 16 bytes), longer
+ * inputs are accepted up to this limit
+ */
+const size_t max_key_length = 128;
+
+const char response_prefix[] = "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: ";
+
+const char extensions_prefix[] = "\r\nSec-WebSocket-Extensions: ";
+
+const char response_suffix[] = "\r\n\r\n";
+
+inline void base64_triplet(const unsigned char* src, char* dest) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint32_t val = (static_cast<uint32_t>(src[0]) << 16) |
+            (static_cast<uint32_t>(src[1]) << 8) |
+            static_cast<uint32_t>(src[2]);
+    dest[0] = alphabet[(val >> 18) & 0x3f];
+    dest[1] = alphabet[(val >> 12) & 0x3f];
+    dest[2] = alphabet[(val >> 6) & 0x3f];
+    dest[3] = alphabet[val & 0x3f];
+}
+
+inline char* append(char* dest, const char* src, size_t len) {
+    std::memcpy(dest, src, len);
+    return dest + len;
+}
+
+inline std::string trim(const std::string& st) {
+    size_t begin = 0;
+    while (begin < st.length() && std::isspace(static_cast<unsigned char>(st[begin]))) {
+        begin += 1;
+    }
+    size_t end = st.length();
+    while (end > begin && std::isspace(static_cast<unsigned char>(st[end - 1]))) {
+        end -= 1;
+    }
+    return st.substr(begin, end - begin);
+}
+
+inline std::vector<std::string> split(const std::string& st, char delim) {
+    auto res = std::vector<std::string>();
+    auto cur = std::string();
+    bool quoted = false;
+    for (char ch : st) {
+        if ('"' == ch) {
+            quoted = !quoted;
+        }
+        if (delim == ch && !quoted) {
+            res.emplace_back(trim(cur));
+            cur.clear();
+        } else {
+            cur.push_back(ch);
+        }
+    }
+    res.emplace_back(trim(cur));
+    return res;
+}
+
+inline std::string to_lower(const std::string& st) {
+    auto res = std::string(st);
+    for (auto& ch : res) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return res;
+}
+
+inline bool parse_window_bits(const std::string& value, int& out) {
+    auto val = value;
+    if (val.length() >= 2 && '"' == val.front() && '"' == val.back()) {
+        val = val.substr(1, val.length() - 2);
+    }
+    if (val.empty() || val.length() > 2) {
+        return false;
+    }
+    int res = 0;
+    for (char ch : val) {
+        if (ch < '0' || ch > '9') {
+            return false;
+        }
+        res = res * 10 + (ch - '0');
+    }
+    if (res < 8 || res > 15) {
+        return false;
+    }
+    out = res;
+    return true;
+}
+
+/**
+ * Parses single "permessage-deflate" element of the extensions list,
+ * presence of `client_max_window_bits` (that may have no value)
+ * is reported using the flags
+ */
+inline bool parse_deflate_element(const std::string& element, deflate_params& out,
+        bool& client_bits_present, bool& client_bits_value) {
+    auto parts = split(element, ';');
+    if ("permessage-deflate" != to_lower(parts.front())) {
+        return false;
+    }
+    auto res = deflate_params();
+    client_bits_present = false;
+    client_bits_value = false;
+    bool server_bits_present = false;
+    bool server_ctx_present = false;
+    bool client_ctx_present = false;
+    for (size_t i = 1; i < parts.size(); i++) {
+        auto eq = parts[i].find('=');
+        auto name = to_lower(trim(parts[i].substr(0, eq)));
+        auto value = std::string::npos != eq ? trim(parts[i].substr(eq + 1)) : std::string();
+        bool has_value = std::string::npos != eq;
+        if ("server_no_context_takeover" == name && !has_value && !server_ctx_present) {
+            res.server_no_context_takeover = true;
+            server_ctx_present = true;
+        } else if ("client_no_context_takeover" == name && !has_value && !client_ctx_present) {
+            res.client_no_context_takeover = true;
+            client_ctx_present = true;
+        } else if ("server_max_window_bits" == name && has_value && !server_bits_present) {
+            if (!parse_window_bits(value, res.server_max_window_bits)) {
+                return false;
+            }
+            server_bits_present = true;
+        } else if ("client_max_window_bits" == name && !client_bits_present) {
+            if (has_value && !parse_window_bits(value, res.client_max_window_bits)) {
+                return false;
+            }
+            client_bits_present = true;
+            client_bits_value = has_value;
+        } else {
+            return false;
+        }
+    }
+    out = res;
+    return true;
+}
+
+/**
+ * Checks whether one of the offered elements allows the client
+ * to use the specified window size
+ */
+inline bool client_bits_offered(const std::string& offer, int bits) {
+    for (auto& el : split(offer, ',')) {
+        auto params = deflate_params();
+        bool client_bits = false;
+        bool client_bits_value = false;
+        if (parse_deflate_element(el, params, client_bits, client_bits_value) &&
+                client_bits && params.client_max_window_bits >= bits) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool server_bits_offered(const std::string& offer, int bits) {
+    for (auto& el : split(offer, ',')) {
+        auto params = deflate_params();
+        bool client_bits = false;
+        bool client_bits_value = false;
+        if (parse_deflate_element(el, params, client_bits, client_bits_value) &&
+                params.server_max_window_bits >= bits) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline std::string make_accept_key_string(const std::string& key) {
+    auto concatted = key + accept_guid;
+    auto src = sl::io::array_source(concatted.data(), concatted.length());
+    auto sha1_sink = sl::crypto::make_sha1_sink(sl::io::null_sink());
+    sl::io::copy_all(src, sha1_sink);
+    auto& accept_sha1 = sha1_sink.get_hash();
+    auto accept_sha1_hex_src = sl::io::array_source(accept_sha1.data(), accept_sha1.length());
+    auto accept_sha1_src = sl::io::make_hex_source(accept_sha1_hex_src);
+    auto accept_base64 = sl::io::string_sink();
+    {
+        auto base64_sink = sl::crypto::make_base64_sink(accept_base64);
+        sl::io::copy_all(accept_sha1_src, base64_sink);
+    }
+    return std::move(accept_base64.get_string());
+}
+
+inline std::string format_deflate_params(const deflate_params& params, bool client_bits) {
+    auto res = std::string("permessage-deflate");
+    if (params.server_no_context_takeover) {
+        res += "; server_no_context_takeover";
+    }
+    if (params.client_no_context_takeover) {
+        res += "; client_no_context_takeover";
+    }
+    if (params.server_max_window_bits < 15) {
+        res += "; server_max_window_bits=" + sl::support::to_string(params.server_max_window_bits);
+    }
+    if (client_bits) {
+        res += "; client_max_window_bits";
+        if (params.client_max_window_bits < 15) {
+            res += "=" + sl::support::to_string(params.client_max_window_bits);
+        }
+    }
+    return res;
+}
+
+} // namespace
+
 /**
  * Creates handshake request line
  * 
@@ -82,6 +309,96 @@ inline std::string make_response_line() {
     return "HTTP/1.1 101 Switching Protocols\r\n";
 }
 
+/**
+ * Computes the value of the `Sec-WebSocket-Accept` response header,
+ * does not allocate: SHA-1 is computed over a stack buffer and its
+ * raw bytes are base64-encoded directly into the dest array
+ * 
+ * @param key value of the `Sec-WebSocket-Key` request header
+ * @param out dest array for the accept key
+ * @throws websocket_exception if key is longer than 128 bytes
+ */
+inline void make_accept_key(sl::io::span<const char> key, std::array<char, accept_key_length>& out) {
+    namespace dh = detail_handshake;
+    if (key.size() > dh::max_key_length) {
+        throw websocket_exception(TRACEMSG("Invalid 'Sec-WebSocket-Key' specified,"
+                " length: [" + sl::support::to_string(key.size()) + "]"));
+    }
+    char concatted[dh::max_key_length + dh::accept_guid_length];
+    std::memcpy(concatted, key.data(), key.size());
+    std::memcpy(concatted + key.size(), dh::accept_guid, dh::accept_guid_length);
+    unsigned char hash[SHA_DIGEST_LENGTH + 1];
+    SHA1(reinterpret_cast<const unsigned char*>(concatted), key.size() + dh::accept_guid_length, hash);
+    // 20 bytes: 6 full triplets and a padded pair
+    hash[SHA_DIGEST_LENGTH] = 0;
+    for (size_t i = 0; i < 7; i++) {
+        dh::base64_triplet(hash + i * 3, out.data() + i * 4);
+    }
+    out[accept_key_length - 1] = '=';
+    stats::increment(stats::counter::accept_keys);
+}
+
+/**
+ * Returns the length of the handshake response, that is written by `write_response`
+ * 
+ * @param extensions_len length of the `Sec-WebSocket-Extensions` header value,
+ *        zero if this header is not used
+ * @return response length in bytes
+ */
+inline size_t response_length(size_t extensions_len = 0) {
+    namespace dh = detail_handshake;
+    size_t res = sizeof(dh::response_prefix) - 1 + accept_key_length + sizeof(dh::response_suffix) - 1;
+    if (extensions_len > 0) {
+        res += sizeof(dh::extensions_prefix) - 1 + extensions_len;
+    }
+    return res;
+}
+
+/**
+ * Writes a complete handshake response (status line, headers
+ * and the terminating empty line) into the specified buffer,
+ * does not allocate
+ * 
+ * @param key value of the `Sec-WebSocket-Key` request header
+ * @param extensions value of the `Sec-WebSocket-Extensions` header,
+ *        header is not added if value is empty
+ * @param dest dest buffer, must be at least `response_length(extensions.size())` bytes
+ * @return number of bytes written
+ * @throws websocket_exception if dest buffer is too small
+ */
+inline size_t write_response(sl::io::span<const char> key, sl::io::span<const char> extensions,
+        sl::io::span<char> dest) {
+    namespace dh = detail_handshake;
+    size_t len = response_length(extensions.size());
+    if (dest.size() < len) {
+        throw websocket_exception(TRACEMSG("Insufficient buffer specified for handshake response,"
+                " required: [" + sl::support::to_string(len) + "]," +
+                " buffer size: [" + sl::support::to_string(dest.size()) + "]"));
+    }
+    auto accept = std::array<char, accept_key_length>();
+    make_accept_key(key, accept);
+    char* pos = dest.data();
+    pos = dh::append(pos, dh::response_prefix, sizeof(dh::response_prefix) - 1);
+    pos = dh::append(pos, accept.data(), accept.size());
+    if (extensions.size() > 0) {
+        pos = dh::append(pos, dh::extensions_prefix, sizeof(dh::extensions_prefix) - 1);
+        pos = dh::append(pos, extensions.data(), extensions.size());
+    }
+    pos = dh::append(pos, dh::response_suffix, sizeof(dh::response_suffix) - 1);
+    return static_cast<size_t>(pos - dest.data());
+}
+
+/**
+ * Writes a complete handshake response into the specified buffer
+ * 
+ * @param key value of the `Sec-WebSocket-Key` request header
+ * @param dest dest buffer, must be at least `response_length()` bytes
+ * @return number of bytes written
+ */
+inline size_t write_response(sl::io::span<const char> key, sl::io::span<char> dest) {
+    return write_response(key, sl::io::span<const char>(nullptr, 0), dest);
+}
+
 /**
  * Creates a list of headers for a handshake response
  * 
@@ -90,25 +407,143 @@ inline std::string make_response_line() {
  */
 inline std::vector<std::pair<std::string, std::string>> make_response_headers(
         const std::string& key) {
-    auto concatted = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-    auto src = sl::io::array_source(concatted.data(), concatted.length());
-    auto sha1_sink = sl::crypto::make_sha1_sink(sl::io::null_sink());
-    sl::io::copy_all(src, sha1_sink);
-    auto& accept_sha1 = sha1_sink.get_hash();
-    auto accept_sha1_hex_src = sl::io::array_source(accept_sha1.data(), accept_sha1.length());
-    auto accept_sha1_src = sl::io::make_hex_source(accept_sha1_hex_src);
-    auto accept_base64 = sl::io::string_sink();
-    {
-        auto base64_sink = sl::crypto::make_base64_sink(accept_base64);
-        sl::io::copy_all(accept_sha1_src, base64_sink);
-    }
     auto vec = std::vector<std::pair<std::string, std::string>>();
     vec.emplace_back("Upgrade", "websocket");
     vec.emplace_back("Connection", "Upgrade");
-    vec.emplace_back("Sec-WebSocket-Accept", std::move(accept_base64.get_string()));
+    if (key.length() <= detail_handshake::max_key_length) {
+        auto accept = std::array<char, accept_key_length>();
+        make_accept_key(key, accept);
+        vec.emplace_back("Sec-WebSocket-Accept", std::string(accept.data(), accept.size()));
+    } else {
+        // keys of any length were accepted before the allocation-free path was added
+        vec.emplace_back("Sec-WebSocket-Accept", detail_handshake::make_accept_key_string(key));
+    }
     return vec;
 }
 
+/**
+ * Creates a list of headers for a handshake response, that
+ * includes the accepted extensions
+ * 
+ * @param key value of the `Sec-WebSocket-Key` request header
+ * @param extensions value of the `Sec-WebSocket-Extensions` header,
+ *        header is not added if value is empty
+ * @return list of headers
+ */
+inline std::vector<std::pair<std::string, std::string>> make_response_headers(
+        const std::string& key, const std::string& extensions) {
+    auto vec = make_response_headers(key);
+    if (!extensions.empty()) {
+        vec.emplace_back("Sec-WebSocket-Extensions", extensions);
+    }
+    return vec;
+}
+
+/**
+ * Creates a client "permessage-deflate" extension offer
+ * (value for the `Sec-WebSocket-Extensions` request header)
+ * 
+ * @param params requested extension parameters, `client_max_window_bits`
+ *        of `8` is not supported (zlib cannot compress with 256 bytes window)
+ * @return extension offer
+ * @throws websocket_exception on unsupported client window size
+ */
+inline std::string make_deflate_offer(const deflate_params& params = deflate_params()) {
+    if (params.client_max_window_bits < 9 || params.client_max_window_bits > 15) {
+        throw websocket_exception(TRACEMSG("Unsupported client window bits specified,"
+                " value: [" + sl::support::to_string(params.client_max_window_bits) + "]"));
+    }
+    return detail_handshake::format_deflate_params(params, true);
+}
+
+/**
+ * Server-side negotiation of the "permessage-deflate" extension, picks
+ * the first offer that is acceptable under the specified configuration
+ * 
+ * @param offers value of the `Sec-WebSocket-Extensions` request header
+ * @param config server configuration, window bits are treated as maximums,
+ *        `server_max_window_bits` of `8` is not supported (zlib cannot compress
+ *        with 256 bytes window)
+ * @param agreed negotiated parameters are written here
+ * @return value for the `Sec-WebSocket-Extensions` response header,
+ *         empty string if no offer was accepted
+ */
+inline std::string negotiate_deflate(const std::string& offers, const deflate_params& config,
+        deflate_params& agreed) {
+    for (auto& el : detail_handshake::split(offers, ',')) {
+        auto offer = deflate_params();
+        bool client_bits = false;
+        bool client_bits_value = false;
+        if (!detail_handshake::parse_deflate_element(el, offer, client_bits, client_bits_value)) {
+            continue;
+        }
+        auto res = deflate_params();
+        res.server_no_context_takeover = offer.server_no_context_takeover ||
+                config.server_no_context_takeover;
+        res.client_no_context_takeover = offer.client_no_context_takeover ||
+                config.client_no_context_takeover;
+        res.server_max_window_bits = offer.server_max_window_bits < config.server_max_window_bits ?
+                offer.server_max_window_bits : config.server_max_window_bits;
+        if (res.server_max_window_bits < 9) {
+            continue;
+        }
+        if (client_bits) {
+            res.client_max_window_bits = offer.client_max_window_bits < config.client_max_window_bits ?
+                    offer.client_max_window_bits : config.client_max_window_bits;
+        }
+        agreed = res;
+        return detail_handshake::format_deflate_params(res, client_bits && res.client_max_window_bits < 15);
+    }
+    return std::string();
+}
+
+/**
+ * Client-side check of the "permessage-deflate" extension accepted by server,
+ * `client_max_window_bits` in response must have a value, that is allowed
+ * by the offer, and must not be `8` (zlib cannot compress with 256 bytes window),
+ * `server_max_window_bits` in response must not exceed the offered value
+ * (RFC 7692 section 7.1.2.1)
+ * 
+ * @param response value of the `Sec-WebSocket-Extensions` response header
+ * @param offer value of the `Sec-WebSocket-Extensions` request header
+ * @param agreed negotiated parameters are written here
+ * @return `true` if server accepted the extension with valid parameters, `false` otherwise
+ */
+inline bool parse_deflate_response(const std::string& response, const std::string& offer,
+        deflate_params& agreed) {
+    auto elements = detail_handshake::split(response, ',');
+    if (1 != elements.size()) {
+        return false;
+    }
+    auto res = deflate_params();
+    bool client_bits = false;
+    bool client_bits_value = false;
+    if (!detail_handshake::parse_deflate_element(elements.front(), res, client_bits, client_bits_value)) {
+        return false;
+    }
+    if (client_bits && !(client_bits_value && res.client_max_window_bits >= 9 &&
+            detail_handshake::client_bits_offered(offer, res.client_max_window_bits))) {
+        return false;
+    }
+    if (!detail_handshake::server_bits_offered(offer, res.server_max_window_bits)) {
+        return false;
+    }
+    agreed = res;
+    return true;
+}
+
+/**
+ * Client-side check of the "permessage-deflate" extension accepted by server,
+ * for the offer created with `make_deflate_offer()` with default parameters
+ * 
+ * @param response value of the `Sec-WebSocket-Extensions` response header
+ * @param agreed negotiated parameters are written here
+ * @return `true` if server accepted the extension with valid parameters, `false` otherwise
+ */
+inline bool parse_deflate_response(const std::string& response, deflate_params& agreed) {
+    return parse_deflate_response(response, make_deflate_offer(), agreed);
+}
+
 } // namespace
 }
 }
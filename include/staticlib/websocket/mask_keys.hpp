@@ -0,0 +1,265 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   mask_keys.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_MASK_KEYS_HPP
+#define STATICLIB_WEBSOCKET_MASK_KEYS_HPP
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+
+#include <openssl/rand.h>
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_WINDOWS
+#include <pthread.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_mask {
+
+/**
+ * Number of ChaCha20 blocks generated on each refill, 256 keys
+ */
+const size_t refill_blocks = 16;
+
+inline uint32_t rotl(uint32_t val, int bits) {
+    return (val << bits) | (val >> (32 - bits));
+}
+
+inline void quarter_round(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d ^= a; d = rotl(d, 16);
+    c += d; b ^= c; b = rotl(b, 12);
+    a += b; d ^= a; d = rotl(d, 8);
+    c += d; b ^= c; b = rotl(b, 7);
+}
+
+/**
+ * ChaCha20 block function (RFC 7539, section 2.3), output words
+ * are not serialized, they are used as keys directly
+ *
+ * @param state input state: constants, key, counter and nonce
+ * @param out output block
+ */
+inline void chacha20_block(const std::array<uint32_t, 16>& state, uint32_t* out) {
+    auto x = state;
+    for (int i = 0; i < 10; i++) {
+        quarter_round(x[0], x[4], x[8], x[12]);
+        quarter_round(x[1], x[5], x[9], x[13]);
+        quarter_round(x[2], x[6], x[10], x[14]);
+        quarter_round(x[3], x[7], x[11], x[15]);
+        quarter_round(x[0], x[5], x[10], x[15]);
+        quarter_round(x[1], x[6], x[11], x[12]);
+        quarter_round(x[2], x[7], x[8], x[13]);
+        quarter_round(x[3], x[4], x[9], x[14]);
+    }
+    for (size_t i = 0; i < 16; i++) {
+        out[i] = x[i] + state[i];
+    }
+}
+
+inline std::atomic<uint32_t>& fork_counter() {
+    static std::atomic<uint32_t> counter{0};
+    return counter;
+}
+
+#ifndef STATICLIB_WINDOWS
+inline void on_fork_child() {
+    fork_counter().fetch_add(1, std::memory_order_relaxed);
+}
+#endif // !STATICLIB_WINDOWS
+
+/**
+ * Number of `fork` calls, that created the current process,
+ * counter is incremented in the child process by the `pthread_atfork`
+ * handler, that is registered with the first call
+ *
+ * @return fork generation
+ */
+inline uint32_t fork_generation() {
+#ifndef STATICLIB_WINDOWS
+    static bool registered = 0 == ::pthread_atfork(nullptr, nullptr, on_fork_child);
+    (void) registered;
+#endif // !STATICLIB_WINDOWS
+    return fork_counter().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+/**
+ * Source of masking keys for client frames. Keys are generated in bulk
+ * with ChaCha20 keystream, cipher key and nonce are taken from OpenSSL
+ * `RAND_bytes` and are refreshed after the specified number of keys
+ * and in the child process after `fork` (buffered keys are discarded).
+ * Zero keys (rejected by the receiving side) are skipped.
+ * This header is not included into `staticlib/websocket.hpp`.
+ *
+ * Generator is NOT thread-safe, `thread_mask_keys()` returns
+ * the instance of the calling thread.
+ */
+class mask_key_generator {
+    std::array<uint32_t, 16> state;
+    std::array<uint32_t, 16 * detail_mask::refill_blocks> keys;
+    size_t keys_idx;
+    uint64_t reseed_interval;
+    uint64_t since_reseed = 0;
+    uint32_t generation = 0;
+
+public:
+    /**
+     * Constructor, seeds the generator
+     *
+     * @param reseed_interval_keys number of keys generated before
+     *        ChaCha20 key and nonce are taken from `RAND_bytes` again
+     * @throws websocket_exception if `RAND_bytes` fails
+     */
+    explicit mask_key_generator(uint64_t reseed_interval_keys = 1 << 20) :
+    keys_idx(0),
+    reseed_interval(reseed_interval_keys) {
+        reseed();
+    }
+
+    /**
+     * Deleted copy constructor, copies would generate the same keys
+     *
+     * @param other instance
+     */
+    mask_key_generator(const mask_key_generator&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    mask_key_generator& operator=(const mask_key_generator&) = delete;
+
+    /**
+     * Next masking key
+     *
+     * @return non-zero masking key
+     * @throws websocket_exception if reseeding fails
+     */
+    uint32_t next() {
+        if (detail_mask::fork_counter().load(std::memory_order_relaxed) != generation) {
+            // child process must not repeat the buffered keys of the parent
+            reseed();
+        }
+        for (;;) {
+            if (keys.size() == keys_idx) {
+                refill();
+            }
+            auto res = keys[keys_idx];
+            keys_idx += 1;
+            if (0 != res) {
+                return res;
+            }
+        }
+    }
+
+    /**
+     * Fills the specified array with masking keys
+     *
+     * @param dest dest array
+     * @param count number of keys to generate
+     * @throws websocket_exception if reseeding fails
+     */
+    void fill(uint32_t* dest, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = next();
+        }
+    }
+
+    /**
+     * Takes new ChaCha20 key and nonce from `RAND_bytes`,
+     * buffered keys are discarded
+     *
+     * @throws websocket_exception if `RAND_bytes` fails
+     */
+    void reseed() {
+        auto seed = std::array<uint32_t, 11>();
+        auto err = RAND_bytes(reinterpret_cast<unsigned char*>(seed.data()),
+                static_cast<int>(seed.size() * sizeof(uint32_t)));
+        if (1 != err) {
+            throw websocket_exception(TRACEMSG("Masking keys seeding error, 'RAND_bytes' failed,"
+                    " code: [" + sl::support::to_string(err) + "]"));
+        }
+        // "expand 32-byte k"
+        state[0] = 0x61707865;
+        state[1] = 0x3320646e;
+        state[2] = 0x79622d32;
+        state[3] = 0x6b206574;
+        for (size_t i = 0; i < 8; i++) {
+            state[4 + i] = seed[i];
+        }
+        state[12] = 0;
+        for (size_t i = 0; i < 3; i++) {
+            state[13 + i] = seed[8 + i];
+        }
+        this->keys_idx = keys.size();
+        this->since_reseed = 0;
+        this->generation = detail_mask::fork_generation();
+    }
+
+private:
+    void refill() {
+        // block counter must not wrap around
+        if (since_reseed >= reseed_interval || state[12] > UINT32_MAX - detail_mask::refill_blocks) {
+            reseed();
+        }
+        for (size_t i = 0; i < detail_mask::refill_blocks; i++) {
+            detail_mask::chacha20_block(state, keys.data() + i * 16);
+            state[12] += 1;
+        }
+        this->keys_idx = 0;
+        this->since_reseed += keys.size();
+    }
+};
+
+/**
+ * Masking keys generator of the calling thread
+ *
+ * @return thread-local generator
+ */
+inline mask_key_generator& thread_mask_keys() {
+    static thread_local mask_key_generator gen;
+    return gen;
+}
+
+/**
+ * Next masking key from the generator of the calling thread
+ *
+ * @return non-zero masking key
+ */
+inline uint32_t next_mask_key() {
+    return thread_mask_keys().next();
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_MASK_KEYS_HPP */
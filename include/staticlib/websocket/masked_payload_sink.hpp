@@ -0,0 +1,214 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   masked_payload_sink.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_MASKED_PAYLOAD_SINK_HPP
+#define STATICLIB_WEBSOCKET_MASKED_PAYLOAD_SINK_HPP
+
+#include <cstdint>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * `Sink` wrapper that masks the payload while copying it
+ * to the destination sink, can be used by clients to send the payload
+ * in a streaming mode. Payload passed to `write` is masked through
+ * a 4 KB stack buffer, `mask_into` masks directly into the contiguous
+ * destination buffer (for example, send buffer) without the sink.
+ */
+template<typename Sink>
+class masked_payload_sink {
+    /**
+     * Destination sink
+     */
+    Sink sink;
+    /**
+     * Mask
+     */
+    uint32_t mask;
+    /**
+     * Number of bytes written
+     */
+    size_t payload_idx = 0;
+
+public:
+    /**
+     * Constructor
+     * 
+     * @param sink destination sink
+     * @param mask_val mask value, that was written into the frame header
+     * @param offset number of payload bytes already written before this sink
+     */
+    masked_payload_sink(Sink&& sink, uint32_t mask_val, size_t offset = 0) :
+    sink(std::move(sink)),
+    mask(mask_val),
+    payload_idx(offset) { }
+
+    /**
+     * Deleted copy constructor
+     * 
+     * @param other instance
+     */
+    masked_payload_sink(const masked_payload_sink&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     * 
+     * @param other instance
+     * @return this instance 
+     */
+    masked_payload_sink& operator=(const masked_payload_sink&) = delete;
+
+    /**
+     * Move constructor
+     * 
+     * @param other other instance
+     */
+    masked_payload_sink(masked_payload_sink&& other) :
+    sink(std::move(other.sink)),
+    mask(other.mask),
+    payload_idx(other.payload_idx) { }
+
+    /**
+     * Move assignment operator
+     * 
+     * @param other other instance
+     * @return this instance
+     */
+    masked_payload_sink& operator=(masked_payload_sink&& other) {
+        sink = std::move(other.sink);
+        mask = other.mask;
+        payload_idx = other.payload_idx;
+        return *this;
+    }
+
+    /**
+     * Masking write implementation, data is masked in 4 KB pieces
+     * into the stack buffer, that is written into the destination sink
+     * 
+     * @param span buffer span
+     * @return number of bytes processed
+     */
+    std::streamsize write(sl::io::span<const char> span) {
+        auto buf = std::array<char, 4096>();
+        size_t idx = 0;
+        while (idx < span.size()) {
+            auto rem = span.size() - idx;
+            auto len = rem < buf.size() ? rem : buf.size();
+            apply_mask(span.data() + idx, buf.data(), len, mask, payload_idx);
+            sl::io::write_all(sink, {buf.data(), len});
+            idx += len;
+            payload_idx += len;
+        }
+        return static_cast<std::streamsize>(span.size());
+    }
+
+    /**
+     * Masks the payload directly into the specified buffer, mask phase
+     * is shared with `write`, so both methods can be used for
+     * the same payload; destination sink is not used
+     *
+     * @param src payload part
+     * @param dest dest buffer, must have at least `src.size()` bytes,
+     *        may point to the same memory as `src`
+     * @return span of masked bytes in the dest buffer
+     * @throws websocket_exception if dest buffer is too small
+     */
+    sl::io::span<char> mask_into(sl::io::span<const char> src, sl::io::span<char> dest) {
+        if (dest.size() < src.size()) {
+            throw websocket_exception(TRACEMSG("Invalid dest buffer specified,"
+                    " size: [" + sl::support::to_string(dest.size()) + "]," +
+                    " required: [" + sl::support::to_string(src.size()) + "]"));
+        }
+        apply_mask(src.data(), dest.data(), src.size(), mask, payload_idx);
+        payload_idx += src.size();
+        return sl::io::make_span(dest.data(), src.size());
+    }
+
+    /**
+     * Flushes destination sink
+     * 
+     * @return number of bytes flushed
+     */
+    std::streamsize flush() {
+        return sink.flush();
+    }
+
+    /**
+     * Position in the payload (number of payload bytes written
+     * including the initial offset)
+     * 
+     * @return number of payload bytes written
+     */
+    size_t bytes_written() {
+        return payload_idx;
+    }
+
+    /**
+     * Underlying sink accessor
+     * 
+     * @return underlying sink reference
+     */
+    Sink& get_sink() {
+        return sink;
+    }
+};
+
+/**
+ * Factory function for creating masking sinks,
+ * created sink will own the destination sink
+ * 
+ * @param sink destination sink
+ * @param mask mask value, that was written into the frame header
+ * @return masking sink
+ */
+template<typename Sink,
+        class = typename std::enable_if<!std::is_lvalue_reference<Sink>::value>::type>
+masked_payload_sink<Sink> make_masked_payload_sink(Sink&& sink, uint32_t mask) {
+    return masked_payload_sink<Sink>(std::move(sink), mask);
+}
+
+/**
+ * Factory function for creating masking sinks,
+ * created sink will NOT own the destination sink
+ * 
+ * @param sink destination sink
+ * @param mask mask value, that was written into the frame header
+ * @return masking sink
+ */
+template<typename Sink>
+masked_payload_sink<sl::io::reference_sink<Sink>> make_masked_payload_sink(Sink& sink, uint32_t mask) {
+    return masked_payload_sink<sl::io::reference_sink<Sink>>(
+            sl::io::make_reference_sink(sink), mask);
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_MASKED_PAYLOAD_SINK_HPP */
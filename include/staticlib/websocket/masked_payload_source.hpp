@@ -28,6 +28,9 @@
 
 #include "staticlib/io.hpp"
 
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/stats.hpp"
+
 namespace staticlib {
 namespace websocket {
 
@@ -48,16 +51,25 @@ class masked_payload_source {
      * Number of bytes read
      */
     size_t payload_idx = 0;
+    /**
+     * Mask phase of the first byte of the view
+     */
+    size_t mask_offset = 0;
 
 public:
     /**
      * Constructor
      * 
-     * @param src input source
+     * @param payload_view span pointing to the whole payload or to the part of it
+     * @param mask_val mask value
+     * @param offset position of the first byte of the view in the (63-bit) payload,
+     *        used when large payload is processed in windows
      */
-    masked_payload_source(sl::io::span<const char> payload_view, uint32_t mask_val) :
+    masked_payload_source(sl::io::span<const char> payload_view, uint32_t mask_val,
+            uint64_t offset = 0) :
     payload(payload_view),
-    mask(mask_val) { }
+    mask(mask_val),
+    mask_offset(static_cast<size_t>(offset & 3)) { }
 
     /**
      * Copy constructor
@@ -67,7 +79,8 @@ public:
     masked_payload_source(const masked_payload_source& other) :
     payload(other.payload),
     mask(other.mask),
-    payload_idx(other.payload_idx) { }
+    payload_idx(other.payload_idx),
+    mask_offset(other.mask_offset) { }
 
     /**
      * Copy assignment operator
@@ -79,6 +92,7 @@ public:
         payload = other.payload;
         mask = other.mask;
         payload_idx = other.payload_idx;
+        mask_offset = other.mask_offset;
         return *this;
     }
 
@@ -89,20 +103,18 @@ public:
      * @return number of bytes processed
      */
     std::streamsize read(sl::io::span<char> span) {
-        size_t written = 0;
-        for (size_t dest_idx = 0;
-                written < span.size() && 
-                payload_idx < payload.size();
-                dest_idx++) {
-            auto mask_idx = 3 - (payload_idx % 4);
-            auto mask_byte = reinterpret_cast<uint8_t*>(std::addressof(mask))[mask_idx];
-            char ch = payload.data()[payload_idx] ^ mask_byte;
-            span[dest_idx] = ch;
-            payload_idx += 1;
-            written += 1;
+        size_t avail = payload.size() - payload_idx;
+        size_t len = span.size() < avail ? span.size() : avail;
+        if (len > 0) {
+            apply_mask(payload.data() + payload_idx, span.data(), len, mask, mask_offset + payload_idx);
+            payload_idx += len;
+            if (0 != mask) {
+                stats::increment(stats::counter::bytes_unmasked, len);
+            }
+            return static_cast<std::streamsize>(len);
         }
-        if (written > 0 || payload_idx < payload.size()) {
-            return static_cast<std::streamsize>(written);
+        if (payload_idx < payload.size()) {
+            return 0;
         }
         return std::char_traits<char>::eof();
     }
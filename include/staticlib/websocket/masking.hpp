@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   masking.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_MASKING_HPP
+#define STATICLIB_WEBSOCKET_MASKING_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#if !defined(STATICLIB_WEBSOCKET_DISABLE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STATICLIB_WEBSOCKET_SSE2
+#include <emmintrin.h>
+#endif // SSE2
+#if (defined(__x86_64__) || defined(__i386__)) && ( \
+        (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 5) || \
+        (defined(__clang__) && !defined(__APPLE__) && __clang_major__ >= 4))
+#define STATICLIB_WEBSOCKET_AVX2
+#include <immintrin.h>
+#endif // AVX2
+#endif // !STATICLIB_WEBSOCKET_DISABLE_SIMD
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_masking {
+
+/**
+ * Signature of the bulk masking kernel
+ */
+typedef void (*apply_mask_fun)(const char*, char*, size_t, uint32_t, size_t);
+
+/**
+ * Fills the buffer with mask bytes rotated to the specified phase,
+ * buffer length must be a multiple of 4
+ *
+ * @param mask mask value as read from the frame header
+ * @param offset position of the first byte in the payload
+ * @param pattern dest buffer
+ * @param pattern_len dest buffer length
+ */
+inline void make_pattern(uint32_t mask, size_t offset, char* pattern, size_t pattern_len) {
+    const char key[4] = {
+        static_cast<char>((mask >> 24) & 0xff),
+        static_cast<char>((mask >> 16) & 0xff),
+        static_cast<char>((mask >> 8) & 0xff),
+        static_cast<char>(mask & 0xff)
+    };
+    char rotated[4];
+    for (size_t i = 0; i < 4; i++) {
+        rotated[i] = key[(offset + i) & 3];
+    }
+    for (size_t i = 0; i < pattern_len; i += 4) {
+        std::memcpy(pattern + i, rotated, 4);
+    }
+}
+
+inline void apply_mask_scalar(const char* src, char* dest, size_t len, uint32_t mask, size_t offset) {
+    char pattern[8];
+    make_pattern(mask, offset, pattern, sizeof(pattern));
+    uint64_t pattern_word = 0;
+    std::memcpy(std::addressof(pattern_word), pattern, sizeof(pattern_word));
+    size_t idx = 0;
+    // phase does not change after each 8 bytes
+    for (; idx + 8 <= len; idx += 8) {
+        uint64_t word = 0;
+        std::memcpy(std::addressof(word), src + idx, sizeof(word));
+        word ^= pattern_word;
+        std::memcpy(dest + idx, std::addressof(word), sizeof(word));
+    }
+    for (size_t i = 0; idx < len; idx++, i++) {
+        dest[idx] = src[idx] ^ pattern[i];
+    }
+}
+
+#ifdef STATICLIB_WEBSOCKET_SSE2
+inline void apply_mask_sse2(const char* src, char* dest, size_t len, uint32_t mask, size_t offset) {
+    char pattern[16];
+    make_pattern(mask, offset, pattern, sizeof(pattern));
+    const __m128i pattern_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+    size_t idx = 0;
+    for (; idx + 16 <= len; idx += 16) {
+        __m128i vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + idx));
+        vec = _mm_xor_si128(vec, pattern_vec);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + idx), vec);
+    }
+    apply_mask_scalar(src + idx, dest + idx, len - idx, mask, offset + idx);
+}
+#endif // STATICLIB_WEBSOCKET_SSE2
+
+#ifdef STATICLIB_WEBSOCKET_AVX2
+__attribute__((target("avx2")))
+inline void apply_mask_avx2(const char* src, char* dest, size_t len, uint32_t mask, size_t offset) {
+    char pattern[32];
+    make_pattern(mask, offset, pattern, sizeof(pattern));
+    const __m256i pattern_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+    size_t idx = 0;
+    for (; idx + 64 <= len; idx += 64) {
+        __m256i vec1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + idx));
+        __m256i vec2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + idx + 32));
+        vec1 = _mm256_xor_si256(vec1, pattern_vec);
+        vec2 = _mm256_xor_si256(vec2, pattern_vec);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + idx), vec1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + idx + 32), vec2);
+    }
+    for (; idx + 32 <= len; idx += 32) {
+        __m256i vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + idx));
+        vec = _mm256_xor_si256(vec, pattern_vec);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + idx), vec);
+    }
+    apply_mask_scalar(src + idx, dest + idx, len - idx, mask, offset + idx);
+}
+#endif // STATICLIB_WEBSOCKET_AVX2
+
+inline apply_mask_fun choose_kernel() {
+#ifdef STATICLIB_WEBSOCKET_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return apply_mask_avx2;
+    }
+#endif // STATICLIB_WEBSOCKET_AVX2
+#ifdef STATICLIB_WEBSOCKET_SSE2
+    return apply_mask_sse2;
+#else
+    return apply_mask_scalar;
+#endif // STATICLIB_WEBSOCKET_SSE2
+}
+
+/**
+ * Inputs shorter than this are processed with scalar code
+ * without going through the kernel dispatch, indirect call and
+ * vector setup cost more than they save on small frames
+ * (crossover is between 256 and 512 bytes in `frame_bench`)
+ */
+const size_t simd_threshold = 512;
+
+} // namespace
+
+/**
+ * Applies the mask to the specified data, masking and unmasking are
+ * the same (XOR) operation. Uses the widest vector instructions
+ * available on the current CPU (selected once at runtime),
+ * falls back to the scalar 8-bytes-at-a-time implementation.
+ *
+ * @param src source data
+ * @param dest dest buffer, must have at least `len` bytes, may be the same as `src`
+ * @param len number of bytes to process
+ * @param mask mask value as read from the frame header
+ * @param offset position of the first byte of `src` in the payload,
+ *        used to rotate the mask to the current phase
+ */
+inline void apply_mask(const char* src, char* dest, size_t len, uint32_t mask, size_t offset = 0) {
+    if (len < detail_masking::simd_threshold) {
+        detail_masking::apply_mask_scalar(src, dest, len, mask, offset);
+        return;
+    }
+    static const detail_masking::apply_mask_fun kernel = detail_masking::choose_kernel();
+    kernel(src, dest, len, mask, offset);
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_MASKING_HPP */
@@ -0,0 +1,409 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   message_assembler.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_MESSAGE_ASSEMBLER_HPP
+#define STATICLIB_WEBSOCKET_MESSAGE_ASSEMBLER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_range.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/masked_payload_source.hpp"
+#include "staticlib/websocket/segment_pool.hpp"
+#include "staticlib/websocket/utf8_validator.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Result of passing a frame to the message assembler
+ */
+enum class message_status {
+    /**
+     * Frame was appended, message is not yet complete
+     */
+    incomplete,
+    /**
+     * Message is complete and can be read
+     */
+    complete,
+    /**
+     * Control frame, it is not buffered and must be handled
+     * by the caller, message in progress (if any) is not affected
+     */
+    control,
+    /**
+     * Frame is out of order (unexpected continuation or
+     * new data frame before the previous message is finished)
+     * or is incomplete, message in progress is discarded
+     */
+    protocol_error,
+    /**
+     * Message exceeds the max size, message in progress is discarded
+     */
+    too_big,
+    /**
+     * Text message is not a valid UTF-8, message in progress is discarded
+     */
+    invalid_utf8
+};
+
+/**
+ * Joins fragmented data frames into messages. Payloads are unmasked
+ * directly into the segments taken from the `segment_pool`, message
+ * is exposed as a list of segments and can be optionally flattened.
+ */
+class message_assembler {
+    /**
+     * Segments pool
+     */
+    segment_pool& pool;
+    /**
+     * Max message size in bytes
+     */
+    size_t max_size;
+    /**
+     * Flag shows whether text messages are validated
+     */
+    bool validate_utf8;
+    /**
+     * Validator for the current text message
+     */
+    utf8_validator validator;
+    /**
+     * Segments of the current message
+     */
+    std::vector<std::unique_ptr<char[]>> segments;
+    /**
+     * Size of the current message
+     */
+    size_t msg_size = 0;
+    /**
+     * Type of the current message
+     */
+    frame_type msg_type = frame_type::invalid;
+    /**
+     * Flag shows whether the first frame of the message has RSV1 bit set
+     */
+    bool compressed = false;
+    /**
+     * Flag shows whether the message is in progress
+     */
+    bool in_progress = false;
+    /**
+     * Flag shows whether the message is complete
+     */
+    bool ready = false;
+
+public:
+    /**
+     * Constructor
+     * 
+     * @param segments_pool pool to take message segments from,
+     *        must remain valid during all the assembler use
+     * @param max_message_size max allowed message size in bytes
+     * @param validate_text whether text messages need to be validated as UTF-8,
+     *        should be disabled for compressed messages
+     */
+    message_assembler(segment_pool& segments_pool, size_t max_message_size, bool validate_text = true) :
+    pool(segments_pool),
+    max_size(max_message_size),
+    validate_utf8(validate_text) { }
+
+    /**
+     * Destructor, returns segments to pool
+     */
+    ~message_assembler() STATICLIB_NOEXCEPT {
+        clear();
+    }
+
+    /**
+     * Deleted copy constructor
+     * 
+     * @param other instance
+     */
+    message_assembler(const message_assembler&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     * 
+     * @param other instance
+     * @return this instance 
+     */
+    message_assembler& operator=(const message_assembler&) = delete;
+
+    /**
+     * Move constructor
+     * 
+     * @param other other instance
+     */
+    message_assembler(message_assembler&& other) :
+    pool(other.pool),
+    max_size(other.max_size),
+    validate_utf8(other.validate_utf8),
+    validator(other.validator),
+    segments(std::move(other.segments)),
+    msg_size(other.msg_size),
+    msg_type(other.msg_type),
+    compressed(other.compressed),
+    in_progress(other.in_progress),
+    ready(other.ready) {
+        other.segments.clear();
+        other.msg_size = 0;
+        other.in_progress = false;
+        other.ready = false;
+    }
+
+    /**
+     * Accepts next frame, frame must be complete and well-formed,
+     * `protocol_error` is returned for incomplete frames.
+     * Previously completed message is cleared automatically
+     * when the next data frame is accepted.
+     * 
+     * @param fr complete frame
+     * @return message status after accepting the frame
+     */
+    message_status accept(frame& fr) {
+        if (!fr.is_complete()) {
+            clear();
+            return message_status::protocol_error;
+        }
+        return append(fr.type(), fr.is_final(), fr.is_compressed(), fr.payload_length(),
+                fr.payload_unmasked());
+    }
+
+    /**
+     * Accepts next frame found by `frame_range`.
+     * Previously completed message is cleared automatically
+     * when the next data frame is accepted.
+     * 
+     * @param rec complete frame record
+     * @return message status after accepting the frame
+     */
+    message_status accept(const frame_range::record& rec) {
+        auto& head = rec.header();
+        return append(head.type(), head.is_final(), head.is_compressed(), head.payload_length(),
+                rec.payload_unmasked());
+    }
+
+    /**
+     * Flag shows whether the message is complete
+     * 
+     * @return whether the message is complete
+     */
+    bool is_complete() const {
+        return ready;
+    }
+
+    /**
+     * Type of the message (`text` or `binary`)
+     * 
+     * @return message type
+     */
+    frame_type type() const {
+        return msg_type;
+    }
+
+    /**
+     * Flag shows whether the message is compressed ("permessage-deflate"
+     * RSV1 bit was set on the first frame), compressed message should
+     * be passed through `inflate_sink`
+     * 
+     * @return whether the message is compressed
+     */
+    bool is_compressed() const {
+        return compressed;
+    }
+
+    /**
+     * Message size in bytes
+     * 
+     * @return message size
+     */
+    size_t size() const {
+        return msg_size;
+    }
+
+    /**
+     * Number of segments in the message
+     * 
+     * @return number of segments
+     */
+    size_t segment_count() const {
+        return segments.size();
+    }
+
+    /**
+     * Span pointing to the specified message segment,
+     * all segments except the last one are full
+     * 
+     * @param idx segment index
+     * @return segment span
+     */
+    sl::io::span<const char> segment(size_t idx) const {
+        auto seg_size = pool.segment_size();
+        auto len = idx + 1 < segments.size() ? seg_size : msg_size - idx * seg_size;
+        return sl::io::make_span(static_cast<const char*>(segments.at(idx).get()), len);
+    }
+
+    /**
+     * Writes the message into the specified sink segment by segment
+     * 
+     * @param sink destination sink
+     * @return number of bytes written
+     */
+    template<typename Sink>
+    size_t write_to(Sink& sink) const {
+        for (size_t i = 0; i < segments.size(); i++) {
+            sl::io::write_all(sink, segment(i));
+        }
+        return msg_size;
+    }
+
+    /**
+     * Copies the message into the specified contiguous buffer
+     * 
+     * @param dest dest buffer, must be at least `size()` bytes
+     * @return span pointing to the message in dest buffer
+     */
+    sl::io::span<char> flatten(sl::io::span<char> dest) const {
+        if (dest.size() < msg_size) {
+            throw websocket_exception(TRACEMSG("Insufficient buffer specified for message flattening,"
+                    " message size: [" + sl::support::to_string(msg_size) + "]," +
+                    " buffer size: [" + sl::support::to_string(dest.size()) + "]"));
+        }
+        size_t pos = 0;
+        for (size_t i = 0; i < segments.size(); i++) {
+            auto seg = segment(i);
+            std::memcpy(dest.data() + pos, seg.data(), seg.size());
+            pos += seg.size();
+        }
+        return sl::io::make_span(dest.data(), msg_size);
+    }
+
+    /**
+     * Discards current message, returns segments to pool
+     */
+    void clear() {
+        for (auto& seg : segments) {
+            pool.release(std::move(seg));
+        }
+        segments.clear();
+        this->msg_size = 0;
+        this->msg_type = frame_type::invalid;
+        this->compressed = false;
+        this->in_progress = false;
+        this->ready = false;
+        validator.reset();
+    }
+
+private:
+    message_status append(frame_type ftype, bool final, bool rsv1, uint64_t pl_len,
+            masked_payload_source src) {
+        switch (ftype) {
+        case frame_type::close:
+        case frame_type::ping:
+        case frame_type::pong:
+            return message_status::control;
+        case frame_type::text:
+        case frame_type::binary:
+            if (ready) {
+                clear();
+            }
+            if (in_progress) {
+                clear();
+                return message_status::protocol_error;
+            }
+            this->msg_type = ftype;
+            this->compressed = rsv1;
+            this->in_progress = true;
+            break;
+        case frame_type::continuation:
+            if (!in_progress) {
+                clear();
+                return message_status::protocol_error;
+            }
+            break;
+        default:
+            clear();
+            return message_status::protocol_error;
+        }
+        if (pl_len > max_size - msg_size) {
+            clear();
+            return message_status::too_big;
+        }
+        auto seg_size = pool.segment_size();
+        auto start = msg_size;
+        copy_payload(src, static_cast<size_t>(pl_len));
+        if (validate_utf8 && frame_type::text == msg_type && !compressed) {
+            for (auto pos = start; pos < msg_size; pos = (pos / seg_size + 1) * seg_size) {
+                auto seg = segment(pos / seg_size);
+                auto off = pos % seg_size;
+                validator.update({seg.data() + off, seg.size() - off});
+            }
+            if (!(validator.is_valid() && (!final || validator.is_complete()))) {
+                clear();
+                return message_status::invalid_utf8;
+            }
+        }
+        if (final) {
+            this->in_progress = false;
+            this->ready = true;
+            return message_status::complete;
+        }
+        return message_status::incomplete;
+    }
+
+    void copy_payload(masked_payload_source& src, size_t len) {
+        auto seg_size = pool.segment_size();
+        size_t copied = 0;
+        while (copied < len) {
+            auto seg_pos = msg_size % seg_size;
+            if (msg_size == segments.size() * seg_size) {
+                segments.emplace_back(pool.acquire());
+            }
+            auto free = seg_size - seg_pos;
+            auto rem = len - copied;
+            auto chunk = rem < free ? rem : free;
+            auto read = src.read({segments.back().get() + seg_pos, chunk});
+            if (read <= 0) {
+                break;
+            }
+            copied += static_cast<size_t>(read);
+            this->msg_size += static_cast<size_t>(read);
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_MESSAGE_ASSEMBLER_HPP */
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   outbound_queue.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_OUTBOUND_QUEUE_HPP
+#define STATICLIB_WEBSOCKET_OUTBOUND_QUEUE_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/encoded_frame.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/vectored_encoder.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_outbound {
+
+inline bool is_control(frame_type fr_type) {
+    return 0 != (static_cast<uint8_t>(fr_type) & 0x08);
+}
+
+/**
+ * Queued message, either pre-encoded frame or message payload
+ * that is encoded (and fragmented) when it is written out
+ */
+struct node {
+    std::atomic<node*> next;
+    frame_type type = frame_type::invalid;
+    std::shared_ptr<const encoded_frame> encoded;
+    std::string payload;
+    size_t offset = 0;
+    std::chrono::steady_clock::time_point enqueued;
+
+    node() :
+    next(nullptr) { }
+
+    size_t size() const {
+        return encoded.get() ? encoded->size() : payload.size();
+    }
+};
+
+/**
+ * Intrusive unbounded MPSC list (D. Vyukov's algorithm): push is
+ * wait-free (one atomic exchange), pop is lock-free and can only
+ * be called from the single consumer thread
+ */
+class mpsc_list {
+    std::atomic<node*> tail;
+    node* head;
+
+public:
+    mpsc_list() :
+    tail(new node()),
+    head(tail.load()) { }
+
+    ~mpsc_list() STATICLIB_NOEXCEPT {
+        while (nullptr != head) {
+            auto next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
+        }
+    }
+
+    mpsc_list(const mpsc_list&) = delete;
+
+    mpsc_list& operator=(const mpsc_list&) = delete;
+
+    void push(node* nd) {
+        nd->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = tail.exchange(nd, std::memory_order_acq_rel);
+        prev->next.store(nd, std::memory_order_release);
+    }
+
+    // first node, that is visible to consumer, or null
+    node* peek() {
+        return head->next.load(std::memory_order_acquire);
+    }
+
+    // data of the first node is moved into the current stub node,
+    // that is detached and returned, first node becomes the new stub
+    std::unique_ptr<node> pop() {
+        auto next = head->next.load(std::memory_order_acquire);
+        if (nullptr == next) {
+            return std::unique_ptr<node>();
+        }
+        auto res = std::unique_ptr<node>(head);
+        res->type = next->type;
+        res->encoded = std::move(next->encoded);
+        res->payload = std::move(next->payload);
+        res->offset = 0;
+        res->enqueued = next->enqueued;
+        this->head = next;
+        return res;
+    }
+};
+
+} // namespace
+
+/**
+ * Outbound (server-side) frames queue of a single connection.
+ *
+ * Messages can be pushed from any number of producer threads without locks,
+ * the only consumer (the thread that writes to the connection socket) takes
+ * them out in batches with `fill`. Control frames are kept in a separate list
+ * and are always put into the batch before data messages. Large messages
+ * pushed as payload can be fragmented, so control frames
+ * can be sent between their fragments.
+ *
+ * Batch is filled into `vectored_encoder` and can be written with a single
+ * `writev`/`sendmsg` call. Small messages are coalesced into one batch up
+ * to the byte budget, `flush_due` allows to postpone the write until the budget
+ * is reached or the oldest message waited longer than the latency budget.
+ *
+ * @tparam MaxFrames max number of frames in a single batch
+ */
+template<size_t MaxFrames = 64>
+class outbound_queue {
+    detail_outbound::mpsc_list control;
+    detail_outbound::mpsc_list data;
+    std::atomic<size_t> queued_messages;
+    std::atomic<size_t> queued_bytes;
+    std::atomic<size_t> queued_control;
+    size_t batch_bytes;
+    std::chrono::microseconds max_delay;
+    size_t fragment_size;
+    // consumer-only fields
+    std::unique_ptr<detail_outbound::node> current;
+    std::vector<std::unique_ptr<detail_outbound::node>> in_flight;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param batch_bytes_budget max number of bytes in a single batch, at least one
+     *        message (or fragment) is always put into the batch
+     * @param latency_budget max time the message can wait in the queue
+     *        to be coalesced with the following ones, see `flush_due`
+     * @param max_fragment_size messages pushed as payload are split into
+     *        fragments of this size, `0` to disable fragmentation
+     */
+    outbound_queue(size_t batch_bytes_budget = 65536,
+            std::chrono::microseconds latency_budget = std::chrono::microseconds(0),
+            size_t max_fragment_size = 0) :
+    queued_messages(0),
+    queued_bytes(0),
+    queued_control(0),
+    batch_bytes(batch_bytes_budget),
+    max_delay(latency_budget),
+    fragment_size(max_fragment_size) {
+        if (0 == batch_bytes) {
+            throw websocket_exception(TRACEMSG("Invalid zero batch size specified"));
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    outbound_queue(const outbound_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    outbound_queue& operator=(const outbound_queue&) = delete;
+
+    /**
+     * Queues the pre-encoded frame (for example, shared broadcast frame),
+     * can be called from any thread
+     *
+     * @param frame encoded frame, control frames are prioritized
+     * @return `true` if the queue was empty before this call, consumer
+     *         should be woken up in this case
+     */
+    bool push(std::shared_ptr<const encoded_frame> frame) {
+        auto nd = new detail_outbound::node();
+        nd->type = frame->type();
+        nd->encoded = std::move(frame);
+        return enqueue(nd);
+    }
+
+    /**
+     * Queues the message, payload is copied; can be called from any thread
+     *
+     * @param fr_type frame type, control frames are prioritized
+     * @param payload message payload, up to 125 bytes for control frames
+     * @return `true` if the queue was empty before this call, consumer
+     *         should be woken up in this case
+     * @throws websocket_exception on invalid frame type or control payload length
+     */
+    bool push(frame_type fr_type, sl::io::span<const char> payload) {
+        return push(fr_type, std::string(payload.data(), payload.size()));
+    }
+
+    /**
+     * Queues the message, payload is moved into the queue; can be called from any thread
+     *
+     * @param fr_type frame type, control frames are prioritized
+     * @param payload message payload, up to 125 bytes for control frames
+     * @return `true` if the queue was empty before this call, consumer
+     *         should be woken up in this case
+     * @throws websocket_exception on invalid frame type or control payload length
+     */
+    bool push(frame_type fr_type, std::string&& payload) {
+        if (frame_type::invalid == fr_type || frame_type::continuation == fr_type ||
+                (detail_outbound::is_control(fr_type) && payload.size() > 125)) {
+            throw websocket_exception(TRACEMSG("Invalid message specified,"
+                    " type: [" + sl::support::to_string(static_cast<int>(fr_type)) + "]," +
+                    " payload length: [" + sl::support::to_string(payload.size()) + "]"));
+        }
+        auto nd = new detail_outbound::node();
+        nd->type = fr_type;
+        nd->payload = std::move(payload);
+        return enqueue(nd);
+    }
+
+    /**
+     * Checks whether the consumer should write the batch now:
+     * there are control frames, byte budget is reached
+     * or the oldest message waits longer than latency budget.
+     * Must be called only from the consumer thread.
+     *
+     * @param now current time
+     * @return `true` if the batch should be written
+     */
+    bool flush_due(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) {
+        if (nullptr != current.get() || queued_control.load(std::memory_order_acquire) > 0 ||
+                queued_bytes.load(std::memory_order_acquire) >= batch_bytes) {
+            return true;
+        }
+        auto first = data.peek();
+        return nullptr != first && now - first->enqueued >= max_delay;
+    }
+
+    /**
+     * Puts queued frames into the batch: all control frames first,
+     * then data messages (or fragments of the large message) while
+     * they fit into the byte budget and the batch capacity.
+     * Message larger than the budget is put into the batch alone.
+     * Must be called only from the consumer thread after the previous batch
+     * was written out completely, payloads of the previous batch are released.
+     *
+     * @param batch empty encoder to fill
+     * @return number of frames put into the batch
+     * @throws websocket_exception if batch is not empty
+     */
+    size_t fill(vectored_encoder<MaxFrames>& batch) {
+        if (!batch.empty()) {
+            throw websocket_exception(TRACEMSG("Previous batch is not written,"
+                    " pending bytes: [" + sl::support::to_string(batch.size()) + "]"));
+        }
+        batch.clear();
+        in_flight.clear();
+        size_t frames = 0;
+        size_t bytes = 0;
+        // control frames
+        while (batch.frames_available() > 0) {
+            auto nd = control.pop();
+            if (nullptr == nd.get()) {
+                break;
+            }
+            queued_control.fetch_sub(1, std::memory_order_acq_rel);
+            dequeued(*nd);
+            add_whole(batch, *nd);
+            bytes += nd->size();
+            frames += 1;
+            in_flight.emplace_back(std::move(nd));
+        }
+        // data
+        while (batch.frames_available() > 0 && bytes < batch_bytes) {
+            if (nullptr == current.get()) {
+                auto nd = data.pop();
+                if (nullptr == nd.get()) {
+                    break;
+                }
+                dequeued(*nd);
+                this->current = std::move(nd);
+            }
+            auto& nd = *current;
+            if (nd.encoded.get() || 0 == fragment_size || nd.payload.size() <= fragment_size) {
+                if (frames > 0 && bytes + nd.size() > batch_bytes) {
+                    // stays current until the next batch
+                    break;
+                }
+                add_whole(batch, nd);
+                bytes += nd.size();
+                frames += 1;
+                in_flight.emplace_back(std::move(current));
+                continue;
+            }
+            // next fragment of the large message
+            size_t len = nd.payload.size() - nd.offset < fragment_size ?
+                    nd.payload.size() - nd.offset : fragment_size;
+            if (frames > 0 && bytes + len > batch_bytes) {
+                break;
+            }
+            bool first = 0 == nd.offset;
+            bool last = nd.offset + len == nd.payload.size();
+            batch.add(first ? nd.type : frame_type::continuation,
+                    sl::io::make_span(nd.payload.data() + nd.offset, len), last);
+            nd.offset += len;
+            bytes += len;
+            frames += 1;
+            if (last) {
+                in_flight.emplace_back(std::move(current));
+            } else if (queued_control.load(std::memory_order_acquire) > 0) {
+                // let control frames jump in between the fragments
+                break;
+            }
+        }
+        return frames;
+    }
+
+    /**
+     * Number of messages in the queue (not including the message,
+     * that is partially put into batches as fragments)
+     *
+     * @return number of queued messages
+     */
+    size_t size() const {
+        return queued_messages.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Number of bytes in the queued messages
+     *
+     * @return number of queued bytes
+     */
+    size_t bytes() const {
+        return queued_bytes.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Checks whether there is nothing to write
+     *
+     * @return `true` if queue is empty and no message is partially written
+     */
+    bool empty() const {
+        return 0 == size() && nullptr == current.get();
+    }
+
+private:
+    bool enqueue(detail_outbound::node* nd) {
+        nd->enqueued = std::chrono::steady_clock::now();
+        queued_bytes.fetch_add(nd->size(), std::memory_order_acq_rel);
+        // counter is incremented before the node is published,
+        // so consumer never sees it going below zero
+        bool was_empty = 0 == queued_messages.fetch_add(1, std::memory_order_acq_rel);
+        if (detail_outbound::is_control(nd->type)) {
+            queued_control.fetch_add(1, std::memory_order_acq_rel);
+            control.push(nd);
+        } else {
+            data.push(nd);
+        }
+        return was_empty;
+    }
+
+    void dequeued(const detail_outbound::node& nd) {
+        queued_messages.fetch_sub(1, std::memory_order_acq_rel);
+        queued_bytes.fetch_sub(nd.size(), std::memory_order_acq_rel);
+    }
+
+    static void add_whole(vectored_encoder<MaxFrames>& batch, const detail_outbound::node& nd) {
+        if (nd.encoded.get()) {
+            batch.add_encoded(nd.encoded->data());
+        } else {
+            batch.add(nd.type, sl::io::make_span(nd.payload.data(), nd.payload.size()));
+        }
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_OUTBOUND_QUEUE_HPP */
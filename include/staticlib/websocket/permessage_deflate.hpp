@@ -0,0 +1,641 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   permessage_deflate.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_PERMESSAGE_DEFLATE_HPP
+#define STATICLIB_WEBSOCKET_PERMESSAGE_DEFLATE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "zlib.h"
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/deflate_params.hpp"
+#include "staticlib/websocket/encoded_frame.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_deflate {
+
+/**
+ * Trailing bytes of the `Z_SYNC_FLUSH` output, that are stripped
+ * from the compressed messages
+ */
+const std::array<char, 4> sync_tail = {{'\x00', '\x00', '\xff', '\xff'}};
+
+} // namespace
+
+/**
+ * Per-connection "permessage-deflate" compression state, the same
+ * context is reused for all the messages sent over the connection
+ */
+class deflate_context {
+    /**
+     * zlib stream
+     */
+    std::unique_ptr<z_stream> strm;
+    /**
+     * Flag shows whether compression state is reset after each message
+     */
+    bool no_context_takeover;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param window_bits negotiated window size for our side
+     *        (`server_max_window_bits` for servers, `client_max_window_bits` for clients),
+     *        `8` is not supported by zlib
+     * @param no_context_takeover negotiated `*_no_context_takeover` for our side
+     * @param level compression level
+     * @throws websocket_exception on unsupported window size or zlib error
+     */
+    deflate_context(int window_bits = 15, bool no_context_takeover = false,
+            int level = Z_DEFAULT_COMPRESSION) :
+    strm(new z_stream()),
+    no_context_takeover(no_context_takeover) {
+        // zlib silently compresses with 9 bits window when 8 is requested,
+        // peer that inflates with 8 bits would fail
+        if (window_bits < 9 || window_bits > 15) {
+            throw websocket_exception(TRACEMSG("Unsupported compression window bits specified,"
+                    " value: [" + sl::support::to_string(window_bits) + "]"));
+        }
+        auto err = deflateInit2(strm.get(), level, Z_DEFLATED, -window_bits, 8, Z_DEFAULT_STRATEGY);
+        if (Z_OK != err) {
+            throw websocket_exception(TRACEMSG("'deflateInit2' error,"
+                    " window bits: [" + sl::support::to_string(window_bits) + "]," +
+                    " level: [" + sl::support::to_string(level) + "]," +
+                    " code: [" + sl::support::to_string(err) + "]"));
+        }
+    }
+
+    /**
+     * Constructor from negotiated parameters
+     *
+     * @param params negotiated extension parameters
+     * @param server whether our side is a server
+     * @param level compression level
+     */
+    deflate_context(const deflate_params& params, bool server, int level = Z_DEFAULT_COMPRESSION) :
+    deflate_context(server ? params.server_max_window_bits : params.client_max_window_bits,
+            server ? params.server_no_context_takeover : params.client_no_context_takeover,
+            level) { }
+
+    /**
+     * Destructor
+     */
+    ~deflate_context() STATICLIB_NOEXCEPT {
+        if (nullptr != strm.get()) {
+            deflateEnd(strm.get());
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    deflate_context(const deflate_context&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    deflate_context& operator=(const deflate_context&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    deflate_context(deflate_context&& other) :
+    strm(std::move(other.strm)),
+    no_context_takeover(other.no_context_takeover) { }
+
+    /**
+     * zlib stream accessor
+     *
+     * @return zlib stream
+     */
+    z_stream& stream() {
+        return *strm;
+    }
+
+    /**
+     * Must be called at the end of each message
+     */
+    void end_message() {
+        if (no_context_takeover) {
+            deflateReset(strm.get());
+        }
+    }
+};
+
+/**
+ * Per-connection "permessage-deflate" decompression state, the same
+ * context is reused for all the messages received over the connection
+ */
+class inflate_context {
+    /**
+     * zlib stream
+     */
+    std::unique_ptr<z_stream> strm;
+    /**
+     * Flag shows whether decompression state is reset after each message
+     */
+    bool no_context_takeover;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param window_bits negotiated window size for the other side
+     *        (`client_max_window_bits` for servers, `server_max_window_bits` for clients),
+     *        `8` is rounded up to `9`, as zlib compresses with 512 bytes window
+     * @param no_context_takeover negotiated `*_no_context_takeover` for the other side
+     */
+    inflate_context(int window_bits = 15, bool no_context_takeover = false) :
+    strm(new z_stream()),
+    no_context_takeover(no_context_takeover) {
+        auto wbits = window_bits > 9 ? window_bits : 9;
+        auto err = inflateInit2(strm.get(), -wbits);
+        if (Z_OK != err) {
+            throw websocket_exception(TRACEMSG("'inflateInit2' error,"
+                    " window bits: [" + sl::support::to_string(window_bits) + "]," +
+                    " code: [" + sl::support::to_string(err) + "]"));
+        }
+    }
+
+    /**
+     * Constructor from negotiated parameters
+     *
+     * @param params negotiated extension parameters
+     * @param server whether our side is a server
+     */
+    inflate_context(const deflate_params& params, bool server) :
+    inflate_context(server ? params.client_max_window_bits : params.server_max_window_bits,
+            server ? params.client_no_context_takeover : params.server_no_context_takeover) { }
+
+    /**
+     * Destructor
+     */
+    ~inflate_context() STATICLIB_NOEXCEPT {
+        if (nullptr != strm.get()) {
+            inflateEnd(strm.get());
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    inflate_context(const inflate_context&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    inflate_context& operator=(const inflate_context&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    inflate_context(inflate_context&& other) :
+    strm(std::move(other.strm)),
+    no_context_takeover(other.no_context_takeover) { }
+
+    /**
+     * zlib stream accessor
+     *
+     * @return zlib stream
+     */
+    z_stream& stream() {
+        return *strm;
+    }
+
+    /**
+     * Must be called at the end of each message
+     */
+    void end_message() {
+        if (no_context_takeover) {
+            inflateReset(strm.get());
+        }
+    }
+};
+
+/**
+ * `Sink` wrapper that compresses the message payload using the
+ * connection `deflate_context`. `finish()` must be called at the end
+ * of each message, trailing `00 00 ff ff` bytes are not written
+ * to the destination sink.
+ */
+template<typename Sink>
+class deflate_sink {
+    /**
+     * Destination sink
+     */
+    Sink sink;
+    /**
+     * Compression context
+     */
+    deflate_context* ctx;
+    /**
+     * Last output bytes, that are held back until more output is produced
+     */
+    std::array<char, 4> tail;
+    /**
+     * Number of held back bytes
+     */
+    size_t tail_len = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param sink destination sink
+     * @param context connection compression context
+     */
+    deflate_sink(Sink&& sink, deflate_context& context) :
+    sink(std::move(sink)),
+    ctx(std::addressof(context)) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    deflate_sink(const deflate_sink&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    deflate_sink& operator=(const deflate_sink&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    deflate_sink(deflate_sink&& other) :
+    sink(std::move(other.sink)),
+    ctx(other.ctx),
+    tail(other.tail),
+    tail_len(other.tail_len) { }
+
+    /**
+     * Compressing write implementation
+     *
+     * @param span buffer span
+     * @return number of bytes processed
+     */
+    std::streamsize write(sl::io::span<const char> span) {
+        if (span.size() > 0) {
+            run_deflate(span, Z_NO_FLUSH);
+        }
+        return static_cast<std::streamsize>(span.size());
+    }
+
+    /**
+     * Flushes destination sink, doesn't affect compression
+     *
+     * @return number of bytes flushed
+     */
+    std::streamsize flush() {
+        return sink.flush();
+    }
+
+    /**
+     * Finishes the message, writes remaining compressed
+     * data into destination sink
+     */
+    void finish() {
+        run_deflate(sl::io::span<const char>(nullptr, 0), Z_SYNC_FLUSH);
+        if (!(tail_len == detail_deflate::sync_tail.size() &&
+                0 == std::memcmp(tail.data(), detail_deflate::sync_tail.data(), tail_len))) {
+            sl::io::write_all(sink, {tail.data(), tail_len});
+        }
+        this->tail_len = 0;
+        ctx->end_message();
+    }
+
+    /**
+     * Underlying sink accessor
+     *
+     * @return underlying sink reference
+     */
+    Sink& get_sink() {
+        return sink;
+    }
+
+private:
+    void run_deflate(sl::io::span<const char> span, int flush_mode) {
+        auto& strm = ctx->stream();
+        auto buf = std::array<char, 4096>();
+        strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(span.data()));
+        strm.avail_in = static_cast<uInt>(span.size());
+        do {
+            strm.next_out = reinterpret_cast<Bytef*>(buf.data());
+            strm.avail_out = static_cast<uInt>(buf.size());
+            auto err = deflate(std::addressof(strm), flush_mode);
+            if (Z_OK != err && Z_BUF_ERROR != err) {
+                throw websocket_exception(TRACEMSG("'deflate' error, code: [" +
+                        sl::support::to_string(err) + "]"));
+            }
+            emit(buf.data(), buf.size() - strm.avail_out);
+        } while (0 == strm.avail_out || strm.avail_in > 0);
+    }
+
+    void emit(const char* data, size_t len) {
+        auto total = tail_len + len;
+        if (total <= tail.size()) {
+            std::memcpy(tail.data() + tail_len, data, len);
+            this->tail_len = total;
+            return;
+        }
+        // write out everything except last 4 bytes
+        auto out_len = total - tail.size();
+        auto from_tail = out_len < tail_len ? out_len : tail_len;
+        sl::io::write_all(sink, {tail.data(), from_tail});
+        sl::io::write_all(sink, {data, out_len - from_tail});
+        // new tail: remaining old tail bytes followed by data bytes
+        auto new_tail = std::array<char, 4>();
+        size_t idx = 0;
+        for (size_t i = from_tail; i < tail_len; i++) {
+            new_tail[idx++] = tail[i];
+        }
+        for (size_t i = out_len - from_tail; i < len; i++) {
+            new_tail[idx++] = data[i];
+        }
+        this->tail = new_tail;
+        this->tail_len = idx;
+    }
+};
+
+/**
+ * Factory function for creating compressing sinks,
+ * created sink will own the destination sink
+ *
+ * @param sink destination sink
+ * @param context connection compression context
+ * @return compressing sink
+ */
+template<typename Sink,
+        class = typename std::enable_if<!std::is_lvalue_reference<Sink>::value>::type>
+deflate_sink<Sink> make_deflate_sink(Sink&& sink, deflate_context& context) {
+    return deflate_sink<Sink>(std::move(sink), context);
+}
+
+/**
+ * Factory function for creating compressing sinks,
+ * created sink will NOT own the destination sink
+ *
+ * @param sink destination sink
+ * @param context connection compression context
+ * @return compressing sink
+ */
+template<typename Sink>
+deflate_sink<sl::io::reference_sink<Sink>> make_deflate_sink(Sink& sink, deflate_context& context) {
+    return deflate_sink<sl::io::reference_sink<Sink>>(sl::io::make_reference_sink(sink), context);
+}
+
+/**
+ * `Sink` wrapper that decompresses the (unmasked) message payload using
+ * the connection `inflate_context`. `finish()` must be called at the end
+ * of each message.
+ */
+template<typename Sink>
+class inflate_sink {
+    /**
+     * Destination sink
+     */
+    Sink sink;
+    /**
+     * Decompression context
+     */
+    inflate_context* ctx;
+    /**
+     * Max allowed size of the decompressed message
+     */
+    size_t max_size;
+    /**
+     * Number of decompressed bytes written
+     */
+    size_t written = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param sink destination sink
+     * @param context connection decompression context
+     * @param max_message_size max allowed size of the decompressed message
+     */
+    inflate_sink(Sink&& sink, inflate_context& context,
+            size_t max_message_size = std::numeric_limits<size_t>::max()) :
+    sink(std::move(sink)),
+    ctx(std::addressof(context)),
+    max_size(max_message_size) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    inflate_sink(const inflate_sink&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    inflate_sink& operator=(const inflate_sink&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    inflate_sink(inflate_sink&& other) :
+    sink(std::move(other.sink)),
+    ctx(other.ctx),
+    max_size(other.max_size),
+    written(other.written) { }
+
+    /**
+     * Decompressing write implementation
+     *
+     * @param span buffer span
+     * @return number of bytes processed
+     */
+    std::streamsize write(sl::io::span<const char> span) {
+        if (span.size() > 0) {
+            run_inflate(span);
+        }
+        return static_cast<std::streamsize>(span.size());
+    }
+
+    /**
+     * Flushes destination sink
+     *
+     * @return number of bytes flushed
+     */
+    std::streamsize flush() {
+        return sink.flush();
+    }
+
+    /**
+     * Finishes the message, writes remaining decompressed
+     * data into destination sink
+     */
+    void finish() {
+        run_inflate(detail_deflate::sync_tail);
+        ctx->end_message();
+    }
+
+    /**
+     * Number of decompressed bytes written
+     *
+     * @return number of decompressed bytes
+     */
+    size_t bytes_written() {
+        return written;
+    }
+
+    /**
+     * Underlying sink accessor
+     *
+     * @return underlying sink reference
+     */
+    Sink& get_sink() {
+        return sink;
+    }
+
+private:
+    void run_inflate(sl::io::span<const char> span) {
+        auto& strm = ctx->stream();
+        auto buf = std::array<char, 4096>();
+        strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(span.data()));
+        strm.avail_in = static_cast<uInt>(span.size());
+        do {
+            strm.next_out = reinterpret_cast<Bytef*>(buf.data());
+            strm.avail_out = static_cast<uInt>(buf.size());
+            auto err = inflate(std::addressof(strm), Z_SYNC_FLUSH);
+            if (Z_OK != err && Z_BUF_ERROR != err && Z_STREAM_END != err) {
+                throw websocket_exception(TRACEMSG("'inflate' error, code: [" +
+                        sl::support::to_string(err) + "]"));
+            }
+            auto len = buf.size() - strm.avail_out;
+            if (len > max_size - written) {
+                throw websocket_exception(TRACEMSG("Decompressed message size limit exceeded,"
+                        " limit: [" + sl::support::to_string(max_size) + "]"));
+            }
+            sl::io::write_all(sink, {buf.data(), len});
+            this->written += len;
+            if (Z_STREAM_END == err) {
+                // peer finished the stream with BFINAL block
+                inflateReset(std::addressof(strm));
+            } else if (Z_BUF_ERROR == err && 0 != strm.avail_out) {
+                break;
+            }
+        } while (0 == strm.avail_out || strm.avail_in > 0);
+    }
+};
+
+/**
+ * Factory function for creating decompressing sinks,
+ * created sink will own the destination sink
+ *
+ * @param sink destination sink
+ * @param context connection decompression context
+ * @param max_message_size max allowed size of the decompressed message
+ * @return decompressing sink
+ */
+template<typename Sink,
+        class = typename std::enable_if<!std::is_lvalue_reference<Sink>::value>::type>
+inflate_sink<Sink> make_inflate_sink(Sink&& sink, inflate_context& context,
+        size_t max_message_size = std::numeric_limits<size_t>::max()) {
+    return inflate_sink<Sink>(std::move(sink), context, max_message_size);
+}
+
+/**
+ * Factory function for creating decompressing sinks,
+ * created sink will NOT own the destination sink
+ *
+ * @param sink destination sink
+ * @param context connection decompression context
+ * @param max_message_size max allowed size of the decompressed message
+ * @return decompressing sink
+ */
+template<typename Sink>
+inflate_sink<sl::io::reference_sink<Sink>> make_inflate_sink(Sink& sink, inflate_context& context,
+        size_t max_message_size = std::numeric_limits<size_t>::max()) {
+    return inflate_sink<sl::io::reference_sink<Sink>>(sl::io::make_reference_sink(sink),
+            context, max_message_size);
+}
+
+/**
+ * Compresses the message once and encodes it into a shared immutable frame,
+ * that can be sent to multiple recipients. Compressed bytes depend on
+ * the context state, so the same frame can be sent only to the connections
+ * that negotiated `server_no_context_takeover` (context must be created
+ * with `no_context_takeover` flag) or to the single connection that owns the context.
+ *
+ * @param context compression context
+ * @param fr_type frame type
+ * @param payload message payload
+ * @return shared encoded frame with RSV1 bit set
+ */
+inline std::shared_ptr<const encoded_frame> make_compressed_frame(deflate_context& context,
+        frame_type fr_type, sl::io::span<const char> payload) {
+    auto compressed = sl::io::string_sink();
+    {
+        auto sink = make_deflate_sink(compressed, context);
+        sl::io::write_all(sink, payload);
+        sink.finish();
+    }
+    return make_encoded_frame(fr_type, compressed.get_string(), true);
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_PERMESSAGE_DEFLATE_HPP */
@@ -0,0 +1,344 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   ring_buffer.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_RING_BUFFER_HPP
+#define STATICLIB_WEBSOCKET_RING_BUFFER_HPP
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+#error "Mirrored ring buffer is not supported on Windows"
+#endif // STATICLIB_WINDOWS
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef STATICLIB_LINUX
+#include <sys/syscall.h>
+#endif // STATICLIB_LINUX
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_ring {
+
+inline std::string errno_str() {
+    return std::string(::strerror(errno));
+}
+
+inline size_t page_size() {
+    auto res = ::sysconf(_SC_PAGESIZE);
+    return res > 0 ? static_cast<size_t>(res) : 4096;
+}
+
+// anonymous shared memory file descriptor, file is not visible in the filesystem
+inline int open_shared_memory(size_t len) {
+    int fd = -1;
+#if defined(STATICLIB_LINUX) && defined(SYS_memfd_create)
+    fd = static_cast<int>(::syscall(SYS_memfd_create, "staticlib_websocket_ring", 0));
+#endif // STATICLIB_LINUX && SYS_memfd_create
+    if (-1 == fd) {
+        // older kernels and other systems, name is unlinked right away;
+        // name is kept under 31 chars, that is the limit on macOS and BSD
+        static std::atomic<uint32_t> counter{0};
+        auto name = std::string();
+        do {
+            name = std::string("/slwsr_") + sl::support::to_string(::getpid()) +
+                    "_" + sl::support::to_string(counter.fetch_add(1));
+            fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            // name may be left by the crashed process with the same PID
+        } while (-1 == fd && EEXIST == errno);
+        if (-1 == fd) {
+            throw websocket_exception(TRACEMSG("Shared memory open error,"
+                    " name: [" + name + "], error: [" + errno_str() + "]"));
+        }
+        ::shm_unlink(name.c_str());
+    }
+    if (-1 == ::ftruncate(fd, static_cast<off_t>(len))) {
+        auto err = errno_str();
+        ::close(fd);
+        throw websocket_exception(TRACEMSG("Shared memory resize error,"
+                " size: [" + sl::support::to_string(len) + "], error: [" + err + "]"));
+    }
+    return fd;
+}
+
+// maps the same pages twice, back to back
+inline char* map_mirrored(size_t len) {
+    int fd = open_shared_memory(len);
+    // reserve address space for both mappings
+    void* base = ::mmap(nullptr, len * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == base) {
+        auto err = errno_str();
+        ::close(fd);
+        throw websocket_exception(TRACEMSG("Address space reservation error,"
+                " size: [" + sl::support::to_string(len * 2) + "], error: [" + err + "]"));
+    }
+    char* first = static_cast<char*>(base);
+    void* lower = ::mmap(first, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void* upper = MAP_FAILED;
+    if (MAP_FAILED != lower) {
+        upper = ::mmap(first + len, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    }
+    auto err = errno_str();
+    // mappings keep the memory alive
+    ::close(fd);
+    if (MAP_FAILED == lower || MAP_FAILED == upper) {
+        ::munmap(base, len * 2);
+        throw websocket_exception(TRACEMSG("Mirrored mapping error,"
+                " size: [" + sl::support::to_string(len) + "], error: [" + err + "]"));
+    }
+    return first;
+}
+
+} // namespace
+
+/**
+ * Receive buffer built on the "magic ring buffer" trick: the same
+ * physical pages are mapped twice back to back, so any region of up
+ * to `capacity()` bytes, that starts inside the buffer, is contiguous in
+ * virtual memory. Received data can be passed to `frame`, `frame_range`
+ * or `frame_parser` as a single span even when it wraps around the end of
+ * the buffer, without compacting (`memmove`) the buffer.
+ *
+ * Data is written into the span returned from `reserve` (with `recv`/`read`,
+ * or with a single-element `readv`) and published with `commit`,
+ * readable data is returned from `data` and is released with `consume`.
+ *
+ * Buffer is NOT thread-safe, capacity is rounded up to the page size.
+ */
+class ring_buffer {
+    char* base = nullptr;
+    size_t cap = 0;
+    size_t head = 0;
+    size_t len = 0;
+
+public:
+    /**
+     * Constructor, maps the buffer memory
+     *
+     * @param min_capacity min buffer capacity, rounded up to the page size
+     * @throws websocket_exception on mapping error
+     */
+    explicit ring_buffer(size_t min_capacity) {
+        if (0 == min_capacity) {
+            throw websocket_exception(TRACEMSG("Invalid zero ring buffer capacity specified"));
+        }
+        auto page = detail_ring::page_size();
+        this->cap = ((min_capacity + page - 1) / page) * page;
+        this->base = detail_ring::map_mirrored(cap);
+    }
+
+    /**
+     * Destructor, unmaps the buffer memory
+     */
+    ~ring_buffer() STATICLIB_NOEXCEPT {
+        if (nullptr != base) {
+            ::munmap(base, cap * 2);
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    ring_buffer(const ring_buffer&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    ring_buffer& operator=(const ring_buffer&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    ring_buffer(ring_buffer&& other) STATICLIB_NOEXCEPT :
+    base(other.base),
+    cap(other.cap),
+    head(other.head),
+    len(other.len) {
+        other.base = nullptr;
+        other.cap = 0;
+        other.head = 0;
+        other.len = 0;
+    }
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    ring_buffer& operator=(ring_buffer&& other) STATICLIB_NOEXCEPT {
+        if (this != &other) {
+            if (nullptr != base) {
+                ::munmap(base, cap * 2);
+            }
+            base = other.base;
+            cap = other.cap;
+            head = other.head;
+            len = other.len;
+            other.base = nullptr;
+            other.cap = 0;
+            other.head = 0;
+            other.len = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * Contiguous free space, that can be filled with received data
+     *
+     * @return free space, empty span if buffer is full
+     */
+    sl::io::span<char> reserve() {
+        return sl::io::make_span(base + tail(), cap - len);
+    }
+
+    /**
+     * Contiguous free space of the specified size
+     *
+     * @param size number of bytes
+     * @return free space of the specified size
+     * @throws websocket_exception if there is not enough free space
+     */
+    sl::io::span<char> reserve(size_t size) {
+        if (size > cap - len) {
+            throw websocket_exception(TRACEMSG("Ring buffer overflow,"
+                    " requested: [" + sl::support::to_string(size) + "]," +
+                    " available: [" + sl::support::to_string(cap - len) + "]"));
+        }
+        return sl::io::make_span(base + tail(), size);
+    }
+
+    /**
+     * Publishes the data written into the reserved space
+     *
+     * @param written number of bytes written
+     * @throws websocket_exception if more bytes are committed than are free
+     */
+    void commit(size_t written) {
+        if (written > cap - len) {
+            throw websocket_exception(TRACEMSG("Invalid committed bytes count specified,"
+                    " committed: [" + sl::support::to_string(written) + "]," +
+                    " available: [" + sl::support::to_string(cap - len) + "]"));
+        }
+        len += written;
+    }
+
+    /**
+     * All readable data as a contiguous span
+     *
+     * @return readable data
+     */
+    sl::io::span<const char> data() const {
+        return sl::io::make_span(const_cast<const char*>(base) + head, len);
+    }
+
+    /**
+     * Releases the specified number of bytes from the beginning
+     * of the readable data
+     *
+     * @param read number of bytes processed
+     * @throws websocket_exception if more bytes are consumed than are readable
+     */
+    void consume(size_t read) {
+        if (read > len) {
+            throw websocket_exception(TRACEMSG("Invalid consumed bytes count specified,"
+                    " consumed: [" + sl::support::to_string(read) + "]," +
+                    " readable: [" + sl::support::to_string(len) + "]"));
+        }
+        len -= read;
+        head = 0 == len ? 0 : (head + read) % cap;
+    }
+
+    /**
+     * Drops all readable data
+     */
+    void clear() {
+        head = 0;
+        len = 0;
+    }
+
+    /**
+     * Number of readable bytes
+     *
+     * @return readable bytes count
+     */
+    size_t size() const {
+        return len;
+    }
+
+    /**
+     * Number of free bytes
+     *
+     * @return free bytes count
+     */
+    size_t available() const {
+        return cap - len;
+    }
+
+    /**
+     * Buffer capacity
+     *
+     * @return capacity in bytes
+     */
+    size_t capacity() const {
+        return cap;
+    }
+
+    /**
+     * Checks whether there is no readable data
+     *
+     * @return `true` if buffer is empty
+     */
+    bool empty() const {
+        return 0 == len;
+    }
+
+private:
+    size_t tail() const {
+        return (head + len) % cap;
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_RING_BUFFER_HPP */
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   role.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_ROLE_HPP
+#define STATICLIB_WEBSOCKET_ROLE_HPP
+
+#include <cstdint>
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Server-side policy: frames received from clients must be masked,
+ * frames sent to clients must not be masked
+ */
+struct server_role {
+    /**
+     * Whether role-specific rules are enforced
+     */
+    static const bool strict = true;
+    /**
+     * Whether received frames must be masked
+     */
+    static const bool incoming_masked = true;
+    /**
+     * Whether sent frames must be masked
+     */
+    static const bool outgoing_masked = false;
+};
+
+/**
+ * Client-side policy: frames received from server must not be masked,
+ * frames sent to server must be masked
+ */
+struct client_role {
+    /**
+     * Whether role-specific rules are enforced
+     */
+    static const bool strict = true;
+    /**
+     * Whether received frames must be masked
+     */
+    static const bool incoming_masked = false;
+    /**
+     * Whether sent frames must be masked
+     */
+    static const bool outgoing_masked = true;
+};
+
+/**
+ * Role-agnostic policy, only the frame structure is checked,
+ * both masked and unmasked frames are accepted
+ */
+struct any_role {
+    /**
+     * Whether role-specific rules are enforced
+     */
+    static const bool strict = false;
+    /**
+     * Not used
+     */
+    static const bool incoming_masked = false;
+    /**
+     * Not used
+     */
+    static const bool outgoing_masked = false;
+};
+
+namespace detail_role {
+
+/**
+ * Checks the first two header bytes against RFC 6455 rules for the role:
+ * masking direction, RSV bits (only the negotiated ones are allowed,
+ * RSV1 is allowed only on the first frame of a data message),
+ * control frames must be final, not compressed and not longer than 125 bytes.
+ * Checks are combined without branches, for `any_role` the function
+ * compiles to a constant.
+ *
+ * @param b0 first header byte
+ * @param b1 second header byte
+ * @param allowed_rsv RSV bits allowed by the negotiated extensions (RSV1 is `0x04`)
+ * @return `true` if frame conforms to the role rules
+ */
+template<typename Role>
+bool check_prefix(uint8_t b0, uint8_t b1, uint8_t allowed_rsv) {
+    if (!Role::strict) {
+        return true;
+    }
+    unsigned masked = (b1 >> 7) & 1u;
+    unsigned len7 = b1 & 0x7Fu;
+    unsigned rsv = (b0 >> 4) & 0x07u;
+    unsigned fin = (b0 >> 7) & 1u;
+    unsigned opcode = b0 & 0x0Fu;
+    unsigned control = (opcode >> 3) & 1u;
+    unsigned continuation = 0 == opcode ? 1u : 0u;
+    unsigned bad = (masked ^ (Role::incoming_masked ? 1u : 0u)) |
+            (0 != (rsv & ~static_cast<unsigned>(allowed_rsv)) ? 1u : 0u) |
+            (continuation & (rsv >> 2)) |
+            (control & ((len7 > 125 ? 1u : 0u) | (fin ^ 1u) | (0 != rsv ? 1u : 0u)));
+    return 0 == bad;
+}
+
+} // namespace
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_ROLE_HPP */
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   segment_pool.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_SEGMENT_POOL_HPP
+#define STATICLIB_WEBSOCKET_SEGMENT_POOL_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Pool of reusable fixed-size buffer segments, is NOT thread-safe,
+ * is intended to be shared between connections handled by the same thread
+ */
+class segment_pool {
+    /**
+     * Size of each segment in bytes
+     */
+    size_t seg_size;
+    /**
+     * Max number of free segments kept in pool
+     */
+    size_t max_cached;
+    /**
+     * Free segments
+     */
+    std::vector<std::unique_ptr<char[]>> free_list;
+
+public:
+    /**
+     * Constructor
+     * 
+     * @param segment_size size of each segment in bytes
+     * @param max_cached_segments max number of free segments kept in pool,
+     *        segments released above this limit are freed
+     */
+    segment_pool(size_t segment_size = 4096, size_t max_cached_segments = 1024) :
+    seg_size(segment_size),
+    max_cached(max_cached_segments) {
+        free_list.reserve(max_cached);
+    }
+
+    /**
+     * Deleted copy constructor
+     * 
+     * @param other instance
+     */
+    segment_pool(const segment_pool&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     * 
+     * @param other instance
+     * @return this instance 
+     */
+    segment_pool& operator=(const segment_pool&) = delete;
+
+    /**
+     * Move constructor
+     * 
+     * @param other other instance
+     */
+    segment_pool(segment_pool&& other) :
+    seg_size(other.seg_size),
+    max_cached(other.max_cached),
+    free_list(std::move(other.free_list)) { }
+
+    /**
+     * Move assignment operator
+     * 
+     * @param other other instance
+     * @return this instance
+     */
+    segment_pool& operator=(segment_pool&& other) {
+        seg_size = other.seg_size;
+        max_cached = other.max_cached;
+        free_list = std::move(other.free_list);
+        return *this;
+    }
+
+    /**
+     * Takes a segment from pool, allocates a new one if pool is empty
+     * 
+     * @return segment of `segment_size()` bytes
+     */
+    std::unique_ptr<char[]> acquire() {
+        if (!free_list.empty()) {
+            auto res = std::move(free_list.back());
+            free_list.pop_back();
+            return res;
+        }
+        return std::unique_ptr<char[]>(new char[seg_size]);
+    }
+
+    /**
+     * Returns segment back to pool
+     * 
+     * @param segment segment previously taken from this pool
+     */
+    void release(std::unique_ptr<char[]> segment) {
+        if (free_list.size() < max_cached) {
+            free_list.emplace_back(std::move(segment));
+        }
+    }
+
+    /**
+     * Size of each segment in bytes
+     * 
+     * @return segment size
+     */
+    size_t segment_size() const {
+        return seg_size;
+    }
+
+    /**
+     * Number of free segments in pool
+     * 
+     * @return number of free segments
+     */
+    size_t cached_count() const {
+        return free_list.size();
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_SEGMENT_POOL_HPP */
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   stats.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_STATS_HPP
+#define STATICLIB_WEBSOCKET_STATS_HPP
+
+#include <cstdint>
+#include <array>
+#include <string>
+
+#ifdef STATICLIB_WEBSOCKET_ENABLE_STATS
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif // STATICLIB_WEBSOCKET_ENABLE_STATS
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame_type.hpp"
+
+namespace staticlib {
+namespace websocket {
+namespace stats {
+
+/**
+ * Hot-path counters, collected only when `STATICLIB_WEBSOCKET_ENABLE_STATS`
+ * macro is defined
+ */
+enum class counter {
+    /**
+     * Decoded headers of continuation frames
+     */
+    frames_continuation,
+    /**
+     * Decoded headers of text frames
+     */
+    frames_text,
+    /**
+     * Decoded headers of binary frames
+     */
+    frames_binary,
+    /**
+     * Decoded headers of close frames
+     */
+    frames_close,
+    /**
+     * Decoded headers of ping frames
+     */
+    frames_ping,
+    /**
+     * Decoded headers of pong frames
+     */
+    frames_pong,
+    /**
+     * Decoding attempts that ended with an incomplete header
+     */
+    headers_incomplete,
+    /**
+     * Payload bytes unmasked while reading from `masked_payload_source`
+     * or while feeding `frame_parser`
+     */
+    bytes_unmasked,
+    /**
+     * Frames rejected because of the unknown opcode
+     */
+    rejected_opcode,
+    /**
+     * Frames rejected because of the zero masking key
+     */
+    rejected_zero_mask,
+    /**
+     * Frames rejected because the most significant bit of 64-bit length is set
+     */
+    rejected_length,
+    /**
+     * Frames rejected because of the role rules violation (masking direction,
+     * RSV bits, control frame constraints)
+     */
+    rejected_role,
+    /**
+     * Complete and valid upgrade requests parsed
+     */
+    handshake_requests,
+    /**
+     * Upgrade requests rejected as malformed or invalid
+     */
+    handshake_rejected,
+    /**
+     * `Sec-WebSocket-Accept` keys computed
+     */
+    accept_keys
+};
+
+/**
+ * Number of counters
+ */
+const size_t counters_count = static_cast<size_t>(counter::accept_keys) + 1;
+
+/**
+ * Name of the counter, that can be used as a metric name
+ *
+ * @param cn counter
+ * @return counter name
+ */
+inline const char* counter_name(counter cn) {
+    static const char* names[] = {
+        "frames_continuation",
+        "frames_text",
+        "frames_binary",
+        "frames_close",
+        "frames_ping",
+        "frames_pong",
+        "headers_incomplete",
+        "bytes_unmasked",
+        "rejected_opcode",
+        "rejected_zero_mask",
+        "rejected_length",
+        "rejected_role",
+        "handshake_requests",
+        "handshake_rejected",
+        "accept_keys"
+    };
+    return names[static_cast<size_t>(cn)];
+}
+
+/**
+ * Aggregated values of all counters at the moment of the snapshot
+ */
+class snapshot_type {
+    std::array<uint64_t, counters_count> values;
+
+public:
+    /**
+     * Constructor, all values are zero
+     */
+    snapshot_type() {
+        values.fill(0);
+    }
+
+    /**
+     * Counter value
+     *
+     * @param cn counter
+     * @return value
+     */
+    uint64_t get(counter cn) const {
+        return values[static_cast<size_t>(cn)];
+    }
+
+    /**
+     * Adds to the counter value
+     *
+     * @param cn counter
+     * @param val value to add
+     */
+    void add(counter cn, uint64_t val) {
+        values[static_cast<size_t>(cn)] += val;
+    }
+
+    /**
+     * Formats all counters as a flat JSON object
+     *
+     * @return JSON string
+     */
+    std::string to_json() const {
+        auto res = std::string("{");
+        for (size_t i = 0; i < counters_count; i++) {
+            if (i > 0) {
+                res += ", ";
+            }
+            res += "\"";
+            res += counter_name(static_cast<counter>(i));
+            res += "\": ";
+            res += sl::support::to_string(values[i]);
+        }
+        res += "}";
+        return res;
+    }
+};
+
+#ifdef STATICLIB_WEBSOCKET_ENABLE_STATS
+
+namespace detail_stats {
+
+class thread_counters;
+
+/**
+ * List of live per-thread counters, values of finished threads are
+ * accumulated in `retired`
+ */
+struct registry {
+    std::mutex mtx;
+    std::vector<thread_counters*> threads;
+    snapshot_type retired;
+};
+
+inline registry& get_registry() {
+    static registry reg;
+    return reg;
+}
+
+/**
+ * Counters of a single thread, only the owning thread writes them,
+ * so increments are plain relaxed load-store pairs without locked instructions
+ */
+class thread_counters {
+    std::array<std::atomic<uint64_t>, counters_count> values;
+
+public:
+    thread_counters() {
+        for (auto& va : values) {
+            va.store(0, std::memory_order_relaxed);
+        }
+        auto& reg = get_registry();
+        std::lock_guard<std::mutex> guard{reg.mtx};
+        reg.threads.push_back(this);
+    }
+
+    ~thread_counters() {
+        auto& reg = get_registry();
+        std::lock_guard<std::mutex> guard{reg.mtx};
+        add_to(reg.retired);
+        auto it = std::find(reg.threads.begin(), reg.threads.end(), this);
+        if (reg.threads.end() != it) {
+            reg.threads.erase(it);
+        }
+    }
+
+    thread_counters(const thread_counters&) = delete;
+
+    thread_counters& operator=(const thread_counters&) = delete;
+
+    void increment(counter cn, uint64_t val) {
+        auto& va = values[static_cast<size_t>(cn)];
+        va.store(va.load(std::memory_order_relaxed) + val, std::memory_order_relaxed);
+    }
+
+    void add_to(snapshot_type& snap) const {
+        for (size_t i = 0; i < counters_count; i++) {
+            snap.add(static_cast<counter>(i), values[i].load(std::memory_order_relaxed));
+        }
+    }
+};
+
+inline thread_counters& local_counters() {
+    static thread_local thread_counters tc;
+    return tc;
+}
+
+} // namespace
+
+#endif // STATICLIB_WEBSOCKET_ENABLE_STATS
+
+/**
+ * Flag shows whether stats collection is compiled in
+ *
+ * @return `true` if `STATICLIB_WEBSOCKET_ENABLE_STATS` is defined
+ */
+inline bool enabled() {
+#ifdef STATICLIB_WEBSOCKET_ENABLE_STATS
+    return true;
+#else
+    return false;
+#endif // STATICLIB_WEBSOCKET_ENABLE_STATS
+}
+
+/**
+ * Increments the counter of the calling thread, compiles to nothing
+ * when stats are disabled
+ *
+ * @param cn counter
+ * @param val value to add
+ */
+inline void increment(counter cn, uint64_t val = 1) {
+#ifdef STATICLIB_WEBSOCKET_ENABLE_STATS
+    detail_stats::local_counters().increment(cn, val);
+#else
+    (void) cn;
+    (void) val;
+#endif // STATICLIB_WEBSOCKET_ENABLE_STATS
+}
+
+/**
+ * Increments the per-opcode counter for the decoded frame header
+ *
+ * @param fr_type frame type
+ */
+inline void frame_decoded(frame_type fr_type) {
+    switch (fr_type) {
+    case frame_type::continuation: increment(counter::frames_continuation); break;
+    case frame_type::text: increment(counter::frames_text); break;
+    case frame_type::binary: increment(counter::frames_binary); break;
+    case frame_type::close: increment(counter::frames_close); break;
+    case frame_type::ping: increment(counter::frames_ping); break;
+    case frame_type::pong: increment(counter::frames_pong); break;
+    default: break;
+    }
+}
+
+/**
+ * Aggregates counters of all threads (including finished ones),
+ * counters may be updated concurrently, so the values are not
+ * guaranteed to be consistent with each other
+ *
+ * @return snapshot, all values are zero when stats are disabled
+ */
+inline snapshot_type snapshot() {
+    auto res = snapshot_type();
+#ifdef STATICLIB_WEBSOCKET_ENABLE_STATS
+    auto& reg = detail_stats::get_registry();
+    std::lock_guard<std::mutex> guard{reg.mtx};
+    res = reg.retired;
+    for (auto th : reg.threads) {
+        th->add_to(res);
+    }
+#endif // STATICLIB_WEBSOCKET_ENABLE_STATS
+    return res;
+}
+
+} // namespace
+}
+}
+
+#endif /* STATICLIB_WEBSOCKET_STATS_HPP */
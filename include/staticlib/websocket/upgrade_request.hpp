@@ -0,0 +1,438 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   upgrade_request.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_UPGRADE_REQUEST_HPP
+#define STATICLIB_WEBSOCKET_UPGRADE_REQUEST_HPP
+
+#include <array>
+#include <cstring>
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/stats.hpp"
+
+namespace staticlib {
+namespace websocket {
+namespace handshake {
+
+/**
+ * Result of the upgrade request parsing
+ */
+enum class request_status {
+    /**
+     * Request is parsed successfully and is a valid WebSocket upgrade request
+     */
+    complete,
+    /**
+     * More bytes are needed to parse the request
+     */
+    incomplete,
+    /**
+     * Input is not a valid HTTP request or request head is too large
+     */
+    malformed,
+    /**
+     * Input is a valid HTTP request, but not a valid WebSocket upgrade request
+     * (missing or wrong `Upgrade`, `Connection`, key or version headers)
+     */
+    invalid_upgrade
+};
+
+/**
+ * Max number of repeated `Sec-WebSocket-Protocol` and `Sec-WebSocket-Extensions`
+ * headers recorded by the parser
+ */
+const size_t max_repeated_headers = 4;
+
+/**
+ * Default limit for the size of the request head
+ */
+const size_t default_max_request_size = 8192;
+
+/**
+ * Spans pointing to the values of the header, that may
+ * be repeated in the request
+ */
+struct header_values {
+    /**
+     * Header values in the order they appear in the request
+     */
+    std::array<sl::io::span<const char>, max_repeated_headers> values;
+    /**
+     * Number of values recorded
+     */
+    size_t count = 0;
+};
+
+/**
+ * Upgrade request fields, all spans point into the input buffer
+ * and are valid only while this buffer is alive and unchanged
+ */
+struct upgrade_request {
+    /**
+     * Request method
+     */
+    sl::io::span<const char> method;
+    /**
+     * Request target (path and query)
+     */
+    sl::io::span<const char> target;
+    /**
+     * HTTP version from the request line
+     */
+    sl::io::span<const char> http_version;
+    /**
+     * Value of the `Host` header
+     */
+    sl::io::span<const char> host;
+    /**
+     * Value of the `Upgrade` header
+     */
+    sl::io::span<const char> upgrade;
+    /**
+     * Value of the first `Connection` header
+     */
+    sl::io::span<const char> connection;
+    /**
+     * Value of the `Sec-WebSocket-Key` header
+     */
+    sl::io::span<const char> key;
+    /**
+     * Value of the `Sec-WebSocket-Version` header
+     */
+    sl::io::span<const char> version;
+    /**
+     * Values of the `Sec-WebSocket-Protocol` headers
+     */
+    header_values protocols;
+    /**
+     * Values of the `Sec-WebSocket-Extensions` headers
+     */
+    header_values extensions;
+    /**
+     * Length of the request head including the terminating empty line,
+     * frame data sent right after the request starts at this offset
+     */
+    size_t head_length = 0;
+    /**
+     * Number of bytes already searched for the end of the request head,
+     * used internally to resume parsing when more bytes arrive
+     */
+    size_t scanned = 0;
+};
+
+namespace detail_request {
+
+inline bool is_ows(char ch) {
+    return ' ' == ch || '\t' == ch;
+}
+
+inline bool is_tchar(char ch) {
+    if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9')) {
+        return true;
+    }
+    return '\0' != ch && nullptr != std::strchr("!#$%&'*+-.^_`|~", ch);
+}
+
+inline char lower(char ch) {
+    return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch + ('a' - 'A')) : ch;
+}
+
+inline sl::io::span<const char> trim(const char* begin, const char* end) {
+    while (begin < end && is_ows(*begin)) {
+        begin += 1;
+    }
+    while (end > begin && is_ows(*(end - 1))) {
+        end -= 1;
+    }
+    return sl::io::make_span(begin, static_cast<size_t>(end - begin));
+}
+
+inline bool add_value(header_values& hv, sl::io::span<const char> value) {
+    if (hv.count >= max_repeated_headers) {
+        return false;
+    }
+    hv.values[hv.count] = value;
+    hv.count += 1;
+    return true;
+}
+
+/**
+ * Searches for CRLFCRLF starting from the resume position
+ */
+inline size_t find_head_end(sl::io::span<const char> data, size_t from) {
+    const char* begin = data.data();
+    size_t pos = from < 3 ? 3 : from;
+    while (pos < data.size()) {
+        auto found = static_cast<const char*>(std::memchr(begin + pos, '\n', data.size() - pos));
+        if (nullptr == found) {
+            break;
+        }
+        pos = static_cast<size_t>(found - begin);
+        if ('\r' == begin[pos - 1] && '\n' == begin[pos - 2] && '\r' == begin[pos - 3]) {
+            return pos + 1;
+        }
+        pos += 1;
+    }
+    return 0;
+}
+
+inline bool parse_request_line(const char* begin, const char* end, upgrade_request& req) {
+    auto sp1 = static_cast<const char*>(std::memchr(begin, ' ', static_cast<size_t>(end - begin)));
+    if (nullptr == sp1 || sp1 == begin) {
+        return false;
+    }
+    for (auto ch = begin; ch < sp1; ch++) {
+        if (!is_tchar(*ch)) {
+            return false;
+        }
+    }
+    auto sp2 = static_cast<const char*>(std::memchr(sp1 + 1, ' ', static_cast<size_t>(end - sp1 - 1)));
+    if (nullptr == sp2 || sp2 == sp1 + 1) {
+        return false;
+    }
+    auto ver = sl::io::make_span(sp2 + 1, static_cast<size_t>(end - sp2 - 1));
+    if (8 != ver.size() || 0 != std::memcmp(ver.data(), "HTTP/", 5) || '.' != ver.data()[6]) {
+        return false;
+    }
+    req.method = sl::io::make_span(begin, static_cast<size_t>(sp1 - begin));
+    req.target = sl::io::make_span(sp1 + 1, static_cast<size_t>(sp2 - sp1 - 1));
+    req.http_version = ver;
+    return true;
+}
+
+/**
+ * Parses a single header line, advances the position past the line
+ */
+inline bool parse_header_line(const char*& pos, const char* end,
+        sl::io::span<const char>& name, sl::io::span<const char>& value) {
+    auto line_end = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    if (nullptr == line_end || line_end == pos || '\r' != *(line_end - 1)) {
+        return false;
+    }
+    auto colon = static_cast<const char*>(std::memchr(pos, ':', static_cast<size_t>(line_end - pos)));
+    if (nullptr == colon || colon == pos) {
+        return false;
+    }
+    for (auto ch = pos; ch < colon; ch++) {
+        if (!is_tchar(*ch)) {
+            return false;
+        }
+    }
+    name = sl::io::make_span(pos, static_cast<size_t>(colon - pos));
+    value = trim(colon + 1, line_end - 1);
+    pos = line_end + 1;
+    return true;
+}
+
+} // namespace
+
+/**
+ * Case-insensitive comparison of the span with the specified string
+ *
+ * @param span input span
+ * @param str null-terminated string to compare with
+ * @return `true` if contents are equal ignoring ASCII case
+ */
+inline bool iequals(sl::io::span<const char> span, const char* str) {
+    size_t len = std::strlen(str);
+    if (span.size() != len) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (detail_request::lower(span.data()[i]) != detail_request::lower(str[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Extracts the next element from the comma-separated list,
+ * empty list elements are skipped
+ *
+ * @param list list span, is advanced past the extracted element
+ * @param token span to store the extracted (trimmed) element
+ * @return `false` if list contains no more elements
+ */
+inline bool next_token(sl::io::span<const char>& list, sl::io::span<const char>& token) {
+    const char* pos = list.data();
+    const char* end = list.data() + list.size();
+    while (pos < end) {
+        auto comma = static_cast<const char*>(std::memchr(pos, ',', static_cast<size_t>(end - pos)));
+        auto elem_end = nullptr != comma ? comma : end;
+        auto elem = detail_request::trim(pos, elem_end);
+        pos = nullptr != comma ? comma + 1 : end;
+        if (elem.size() > 0) {
+            list = sl::io::make_span(pos, static_cast<size_t>(end - pos));
+            token = elem;
+            return true;
+        }
+    }
+    list = sl::io::make_span(end, 0);
+    return false;
+}
+
+/**
+ * Checks whether comma-separated list contains the specified token,
+ * comparison is case-insensitive
+ *
+ * @param list comma-separated list
+ * @param token token to look for
+ * @return `true` if token is found
+ */
+inline bool has_token(sl::io::span<const char> list, const char* token) {
+    auto elem = sl::io::span<const char>(nullptr, 0);
+    while (next_token(list, elem)) {
+        if (iequals(elem, token)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace detail_request {
+
+inline request_status parse_head(sl::io::span<const char> data, upgrade_request& req,
+        size_t max_request_size) {
+    namespace dr = detail_request;
+    auto head_len = dr::find_head_end(data, req.scanned);
+    if (0 == head_len) {
+        req.scanned = data.size();
+        return data.size() < max_request_size ? request_status::incomplete : request_status::malformed;
+    }
+    if (head_len > max_request_size) {
+        return request_status::malformed;
+    }
+    auto scanned = req.scanned;
+    req = upgrade_request();
+    req.scanned = scanned;
+    req.head_length = head_len;
+    const char* pos = data.data();
+    const char* end = data.data() + head_len - 2;
+    // request line
+    auto line_end = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    if (line_end == pos || '\r' != *(line_end - 1) || !dr::parse_request_line(pos, line_end - 1, req)) {
+        return request_status::malformed;
+    }
+    pos = line_end + 1;
+    // headers
+    bool connection_upgrade = false;
+    while (pos < end) {
+        auto name = sl::io::span<const char>(nullptr, 0);
+        auto value = sl::io::span<const char>(nullptr, 0);
+        if (!dr::parse_header_line(pos, end, name, value)) {
+            return request_status::malformed;
+        }
+        if (iequals(name, "Host")) {
+            if (req.host.data()) {
+                return request_status::malformed;
+            }
+            req.host = value;
+        } else if (iequals(name, "Upgrade")) {
+            if (req.upgrade.data()) {
+                return request_status::malformed;
+            }
+            req.upgrade = value;
+        } else if (iequals(name, "Connection")) {
+            if (!req.connection.data()) {
+                req.connection = value;
+            }
+            connection_upgrade = connection_upgrade || has_token(value, "upgrade");
+        } else if (iequals(name, "Sec-WebSocket-Key")) {
+            if (req.key.data()) {
+                return request_status::malformed;
+            }
+            req.key = value;
+        } else if (iequals(name, "Sec-WebSocket-Version")) {
+            if (req.version.data()) {
+                return request_status::malformed;
+            }
+            req.version = value;
+        } else if (iequals(name, "Sec-WebSocket-Protocol")) {
+            if (!dr::add_value(req.protocols, value)) {
+                return request_status::malformed;
+            }
+        } else if (iequals(name, "Sec-WebSocket-Extensions")) {
+            if (!dr::add_value(req.extensions, value)) {
+                return request_status::malformed;
+            }
+        }
+    }
+    // websocket-specific checks, RFC 6455 4.2.1
+    bool valid = iequals(req.method, "GET") &&
+            0 != std::memcmp(req.http_version.data(), "HTTP/1.0", 8) &&
+            nullptr != req.host.data() &&
+            has_token(req.upgrade, "websocket") &&
+            connection_upgrade &&
+            24 == req.key.size() &&
+            iequals(req.version, "13");
+    return valid ? request_status::complete : request_status::invalid_upgrade;
+}
+
+} // namespace
+
+/**
+ * Parses the HTTP upgrade request head, does not allocate and does not copy
+ * the input. Can be called repeatedly with the same `req` object as more data
+ * arrives into the same (growing) buffer, already searched part of the input
+ * is not scanned again.
+ *
+ * @param data input buffer containing the beginning of the request
+ * @param req request object to store the parsed fields
+ * @param max_request_size limit for the request head size
+ * @return parsing status
+ */
+inline request_status parse_request(sl::io::span<const char> data, upgrade_request& req,
+        size_t max_request_size = default_max_request_size) {
+    auto status = detail_request::parse_head(data, req, max_request_size);
+    switch (status) {
+    case request_status::complete:
+        stats::increment(stats::counter::handshake_requests);
+        break;
+    case request_status::malformed:
+    case request_status::invalid_upgrade:
+        stats::increment(stats::counter::handshake_rejected);
+        break;
+    default:
+        break;
+    }
+    return status;
+}
+
+/**
+ * Parses the HTTP upgrade request head, does not allocate and does not copy
+ * the input.
+ *
+ * @param data input buffer containing the request head
+ * @param status parsing status
+ * @return parsed request, spans point into the input buffer
+ */
+inline upgrade_request parse_request(sl::io::span<const char> data, request_status& status) {
+    auto req = upgrade_request();
+    status = parse_request(data, req);
+    return req;
+}
+
+} // namespace
+}
+}
+
+#endif /* STATICLIB_WEBSOCKET_UPGRADE_REQUEST_HPP */
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   upgrade_response.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_UPGRADE_RESPONSE_HPP
+#define STATICLIB_WEBSOCKET_UPGRADE_RESPONSE_HPP
+
+#include <array>
+#include <cstring>
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/handshake.hpp"
+#include "staticlib/websocket/upgrade_request.hpp"
+
+namespace staticlib {
+namespace websocket {
+namespace handshake {
+
+/**
+ * Result of the upgrade response validation
+ */
+enum class response_status {
+    /**
+     * Response is a valid `101` upgrade response for the specified key
+     */
+    complete,
+    /**
+     * More bytes are needed to parse the response
+     */
+    incomplete,
+    /**
+     * Input is not a valid HTTP response or response head is too large
+     */
+    malformed,
+    /**
+     * Server did not switch protocols (status is not `101` or
+     * `Upgrade`/`Connection` headers are missing or wrong)
+     */
+    rejected,
+    /**
+     * `Sec-WebSocket-Accept` is missing or does not match the key,
+     * also returned for keys longer than the supported limit
+     */
+    invalid_accept
+};
+
+/**
+ * Upgrade response fields, all spans point into the input buffer
+ * and are valid only while this buffer is alive and unchanged
+ */
+struct upgrade_response {
+    /**
+     * HTTP status code
+     */
+    int status_code = 0;
+    /**
+     * Reason phrase from the status line
+     */
+    sl::io::span<const char> reason;
+    /**
+     * Value of the `Upgrade` header
+     */
+    sl::io::span<const char> upgrade;
+    /**
+     * Value of the first `Connection` header
+     */
+    sl::io::span<const char> connection;
+    /**
+     * Value of the `Sec-WebSocket-Accept` header
+     */
+    sl::io::span<const char> accept;
+    /**
+     * Value of the `Sec-WebSocket-Protocol` header
+     */
+    sl::io::span<const char> protocol;
+    /**
+     * Values of the `Sec-WebSocket-Extensions` headers
+     */
+    header_values extensions;
+    /**
+     * Length of the response head including the terminating empty line,
+     * frames sent by server right after the response start at this offset
+     */
+    size_t head_length = 0;
+    /**
+     * Number of bytes already searched for the end of the response head,
+     * used internally to resume parsing when more bytes arrive
+     */
+    size_t scanned = 0;
+};
+
+namespace detail_response {
+
+inline bool parse_status_line(const char* begin, const char* end, upgrade_response& resp) {
+    // "HTTP/1.1 101"
+    if (end - begin < 12 || 0 != std::memcmp(begin, "HTTP/", 5) || '.' != begin[6] || ' ' != begin[8]) {
+        return false;
+    }
+    int code = 0;
+    for (size_t i = 9; i < 12; i++) {
+        char ch = begin[i];
+        if (ch < '0' || ch > '9') {
+            return false;
+        }
+        code = code * 10 + (ch - '0');
+    }
+    if (end - begin > 12 && ' ' != begin[12]) {
+        return false;
+    }
+    resp.status_code = code;
+    resp.reason = end - begin > 12 ?
+            sl::io::make_span(begin + 13, static_cast<size_t>(end - begin - 13)) :
+            sl::io::make_span(end, 0);
+    return true;
+}
+
+} // namespace
+
+/**
+ * Parses and validates the server handshake response, does not allocate
+ * and does not copy the input. Can be called repeatedly with the same `resp`
+ * object as more data arrives into the same (growing) buffer.
+ * Negotiated protocol and extensions are returned to the caller, it must
+ * check them against the values sent in the request.
+ *
+ * @param data input buffer containing the beginning of the response
+ * @param key value of the `Sec-WebSocket-Key` header sent in the request
+ * @param resp response object to store the parsed fields
+ * @param max_response_size limit for the response head size
+ * @return validation status, on `complete` frame data starts at `resp.head_length`
+ */
+inline response_status parse_response(sl::io::span<const char> data, sl::io::span<const char> key,
+        upgrade_response& resp, size_t max_response_size = default_max_request_size) {
+    namespace dr = detail_request;
+    auto head_len = dr::find_head_end(data, resp.scanned);
+    if (0 == head_len) {
+        resp.scanned = data.size();
+        return data.size() < max_response_size ? response_status::incomplete : response_status::malformed;
+    }
+    if (head_len > max_response_size) {
+        return response_status::malformed;
+    }
+    auto scanned = resp.scanned;
+    resp = upgrade_response();
+    resp.scanned = scanned;
+    resp.head_length = head_len;
+    const char* pos = data.data();
+    const char* end = data.data() + head_len - 2;
+    // status line
+    auto line_end = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    if (line_end == pos || '\r' != *(line_end - 1) ||
+            !detail_response::parse_status_line(pos, line_end - 1, resp)) {
+        return response_status::malformed;
+    }
+    pos = line_end + 1;
+    // headers
+    bool connection_upgrade = false;
+    while (pos < end) {
+        auto name = sl::io::span<const char>(nullptr, 0);
+        auto value = sl::io::span<const char>(nullptr, 0);
+        if (!dr::parse_header_line(pos, end, name, value)) {
+            return response_status::malformed;
+        }
+        if (iequals(name, "Upgrade")) {
+            if (resp.upgrade.data()) {
+                return response_status::malformed;
+            }
+            resp.upgrade = value;
+        } else if (iequals(name, "Connection")) {
+            if (!resp.connection.data()) {
+                resp.connection = value;
+            }
+            connection_upgrade = connection_upgrade || has_token(value, "upgrade");
+        } else if (iequals(name, "Sec-WebSocket-Accept")) {
+            if (resp.accept.data()) {
+                return response_status::malformed;
+            }
+            resp.accept = value;
+        } else if (iequals(name, "Sec-WebSocket-Protocol")) {
+            if (resp.protocol.data()) {
+                return response_status::malformed;
+            }
+            resp.protocol = value;
+        } else if (iequals(name, "Sec-WebSocket-Extensions")) {
+            if (!dr::add_value(resp.extensions, value)) {
+                return response_status::malformed;
+            }
+        }
+    }
+    // client-side checks, RFC 6455 4.1
+    if (101 != resp.status_code || !iequals(resp.upgrade, "websocket") || !connection_upgrade) {
+        return response_status::rejected;
+    }
+    // no accept value can be computed for over-long key without allocation
+    if (key.size() > detail_handshake::max_key_length) {
+        return response_status::invalid_accept;
+    }
+    auto expected = std::array<char, accept_key_length>();
+    make_accept_key(key, expected);
+    if (accept_key_length != resp.accept.size() ||
+            0 != std::memcmp(expected.data(), resp.accept.data(), accept_key_length)) {
+        return response_status::invalid_accept;
+    }
+    return response_status::complete;
+}
+
+} // namespace
+}
+}
+
+#endif /* STATICLIB_WEBSOCKET_UPGRADE_RESPONSE_HPP */
@@ -0,0 +1,620 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   utf8_validator.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_UTF8_VALIDATOR_HPP
+#define STATICLIB_WEBSOCKET_UTF8_VALIDATOR_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/masking.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+namespace detail_utf8 {
+
+/**
+ * DFA states
+ */
+const uint8_t state_accept = 0;
+const uint8_t state_reject = 12;
+
+/**
+ * Number of byte classes
+ */
+const uint8_t classes_count = 12;
+
+/**
+ * Byte classes: ASCII, 3 continuation ranges (80-8F, 90-9F, A0-BF),
+ * invalid bytes, 2-byte leads, E0, other 3-byte leads, ED, F0, F1-F3, F4
+ */
+inline const uint8_t* byte_classes() {
+    static const uint8_t table[256] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+        4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+        6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 7, 9, 10, 10, 10, 11, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4
+    };
+    return table;
+}
+
+/**
+ * Transitions table, indexed with `state + class`, states are stored
+ * premultiplied by `classes_count`: accept, reject, need 1/2/3 continuation
+ * bytes, after E0, after ED, after F0, after F4
+ */
+inline const uint8_t* transitions() {
+    static const uint8_t table[9 * classes_count] = {
+         0, 12, 12, 12, 12, 24, 60, 36, 72, 84, 48, 96, // accept
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, // reject
+        12,  0,  0,  0, 12, 12, 12, 12, 12, 12, 12, 12, // 1 more
+        12, 24, 24, 24, 12, 12, 12, 12, 12, 12, 12, 12, // 2 more
+        12, 36, 36, 36, 12, 12, 12, 12, 12, 12, 12, 12, // 3 more
+        12, 12, 12, 24, 12, 12, 12, 12, 12, 12, 12, 12, // E0: A0-BF
+        12, 24, 24, 12, 12, 12, 12, 12, 12, 12, 12, 12, // ED: 80-9F
+        12, 12, 36, 36, 12, 12, 12, 12, 12, 12, 12, 12, // F0: 90-BF
+        12, 36, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12  // F4: 80-8F
+    };
+    return table;
+}
+
+inline bool is_cont(uint8_t byte) {
+    return 0x80 == (byte & 0xC0);
+}
+
+/**
+ * Checks a complete multibyte sequence starting with a lead byte,
+ * at least 4 bytes must be available
+ *
+ * @return sequence length, `0` if sequence is invalid
+ */
+inline size_t check_sequence(const char* data) {
+    auto b0 = static_cast<uint8_t>(data[0]);
+    auto b1 = static_cast<uint8_t>(data[1]);
+    if (b0 >= 0xC2 && b0 <= 0xDF) {
+        return is_cont(b1) ? 2 : 0;
+    }
+    auto b2 = static_cast<uint8_t>(data[2]);
+    if (b0 >= 0xE0 && b0 <= 0xEF) {
+        uint8_t lo = 0xE0 == b0 ? 0xA0 : 0x80;
+        uint8_t hi = 0xED == b0 ? 0x9F : 0xBF;
+        return b1 >= lo && b1 <= hi && is_cont(b2) ? 3 : 0;
+    }
+    auto b3 = static_cast<uint8_t>(data[3]);
+    if (b0 >= 0xF0 && b0 <= 0xF4) {
+        uint8_t lo = 0xF0 == b0 ? 0x90 : 0x80;
+        uint8_t hi = 0xF4 == b0 ? 0x8F : 0xBF;
+        return b1 >= lo && b1 <= hi && is_cont(b2) && is_cont(b3) ? 4 : 0;
+    }
+    return 0;
+}
+
+/**
+ * Returns the position of the first non-ASCII byte
+ * starting from the specified position
+ */
+inline size_t skip_ascii(const char* data, size_t pos, size_t len) {
+#ifdef STATICLIB_WEBSOCKET_SSE2
+    for (; pos + 16 <= len; pos += 16) {
+        __m128i vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        if (0 != _mm_movemask_epi8(vec)) {
+            break;
+        }
+    }
+#endif // STATICLIB_WEBSOCKET_SSE2
+    for (; pos + 8 <= len; pos += 8) {
+        uint64_t word = 0;
+        std::memcpy(std::addressof(word), data + pos, sizeof(word));
+        if (0 != (word & 0x8080808080808080ULL)) {
+            break;
+        }
+    }
+    while (pos < len && 0 == (static_cast<uint8_t>(data[pos]) & 0x80)) {
+        pos += 1;
+    }
+    return pos;
+}
+
+/**
+ * Returns the position where the last (possibly incomplete) multibyte
+ * sequence of the input starts, or the input length if input ends
+ * with ASCII or with a continuation byte that is at least 4 bytes
+ * away from its lead
+ */
+inline size_t last_boundary(const char* data, size_t pos, size_t len) {
+    for (size_t i = len; i > pos && len - i < 3;) {
+        i -= 1;
+        auto byte = static_cast<uint8_t>(data[i]);
+        if (byte >= 0xC0) {
+            return i;
+        }
+        if (byte < 0x80) {
+            break;
+        }
+    }
+    return len;
+}
+
+/**
+ * Signature of the bulk validation kernel, input must not end
+ * in the middle of a code point
+ */
+typedef bool (*validate_fun)(const char*, size_t);
+
+/**
+ * Inputs shorter than this are validated with scalar code
+ * without going through the kernel dispatch
+ */
+const size_t simd_threshold = 64;
+
+#ifdef STATICLIB_WEBSOCKET_AVX2
+
+// Lookup classifier: "Validating UTF-8 In Less Than One Instruction Per Byte",
+// J. Keiser, D. Lemire, 2021, error kinds are detected from the nibbles
+// of each byte and the byte preceding it
+const uint8_t too_short = 1 << 0;
+const uint8_t too_long = 1 << 1;
+const uint8_t overlong_3 = 1 << 2;
+const uint8_t too_large = 1 << 3;
+const uint8_t surrogate = 1 << 4;
+const uint8_t overlong_2 = 1 << 5;
+const uint8_t too_large_1000 = 1 << 6;
+const uint8_t overlong_4 = 1 << 6;
+const uint8_t two_conts = 1 << 7;
+const uint8_t carry = too_short | too_long | two_conts;
+
+/**
+ * Lookup tables indexed with the high nibble of the previous byte,
+ * low nibble of the previous byte and high nibble of the current byte
+ */
+inline const uint8_t* lookup_tables() {
+    static const uint8_t tables[48] = {
+        // high nibble of the previous byte: ASCII, continuation, leads
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4,
+        // low nibble of the previous byte
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry,
+        carry,
+        carry | too_large,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        // high nibble of the current byte: ASCII, 80-8F, 90-9F, A0-BF, leads
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short
+    };
+    return tables;
+}
+
+/**
+ * Vectors kept between the blocks
+ */
+struct avx2_state {
+    __m256i byte_1_high;
+    __m256i byte_1_low;
+    __m256i byte_2_high;
+    __m256i error;
+    __m256i prev_input;
+    __m256i prev_incomplete;
+};
+
+__attribute__((target("avx2")))
+inline __m256i avx2_load_table(const uint8_t* table) {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+// input shifted by N bytes with the tail of the previous block shifted in
+template<int N>
+__attribute__((target("avx2")))
+inline __m256i avx2_prev(__m256i input, __m256i prev_input) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2")))
+inline __m256i avx2_high_nibbles(__m256i vec) {
+    return _mm256_and_si256(_mm256_srli_epi16(vec, 4), _mm256_set1_epi8(0x0F));
+}
+
+__attribute__((target("avx2")))
+inline void avx2_check_block(avx2_state& st, __m256i input) {
+    if (0 == _mm256_movemask_epi8(input)) {
+        // ASCII block, previous block must not end in the middle of a code point
+        st.error = _mm256_or_si256(st.error, st.prev_incomplete);
+        st.prev_input = input;
+        return;
+    }
+    __m256i prev1 = avx2_prev<1>(input, st.prev_input);
+    __m256i b1h = _mm256_shuffle_epi8(st.byte_1_high, avx2_high_nibbles(prev1));
+    __m256i b1l = _mm256_shuffle_epi8(st.byte_1_low, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    __m256i b2h = _mm256_shuffle_epi8(st.byte_2_high, avx2_high_nibbles(input));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+    // third and fourth bytes of 3- and 4-byte sequences must be continuations
+    __m256i third = _mm256_subs_epu8(avx2_prev<2>(input, st.prev_input), _mm256_set1_epi8(0xE0 - 0x80));
+    __m256i fourth = _mm256_subs_epu8(avx2_prev<3>(input, st.prev_input), _mm256_set1_epi8(0xF0 - 0x80));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    st.error = _mm256_or_si256(st.error, _mm256_xor_si256(must23, special));
+    // leads in the last 3 bytes, that need more bytes than are left in the block
+    __m256i max_value = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    st.prev_incomplete = _mm256_subs_epu8(input, max_value);
+    st.prev_input = input;
+}
+
+__attribute__((target("avx2")))
+inline bool validate_avx2(const char* data, size_t len) {
+    auto tables = lookup_tables();
+    avx2_state st;
+    st.byte_1_high = avx2_load_table(tables);
+    st.byte_1_low = avx2_load_table(tables + 16);
+    st.byte_2_high = avx2_load_table(tables + 32);
+    st.error = _mm256_setzero_si256();
+    st.prev_input = _mm256_setzero_si256();
+    st.prev_incomplete = _mm256_setzero_si256();
+    size_t idx = 0;
+    for (; idx + 32 <= len; idx += 32) {
+        avx2_check_block(st, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + idx)));
+    }
+    if (idx < len) {
+        // zero padding, sequence cut by the end of input is too short
+        char tail[32];
+        std::memset(tail, '\0', sizeof(tail));
+        std::memcpy(tail, data + idx, len - idx);
+        avx2_check_block(st, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail)));
+    }
+    st.error = _mm256_or_si256(st.error, st.prev_incomplete);
+    return 0 != _mm256_testz_si256(st.error, st.error);
+}
+
+#endif // STATICLIB_WEBSOCKET_AVX2
+
+/**
+ * Selects the vector validation kernel for the current CPU
+ *
+ * @return kernel, `nullptr` if only scalar validation is available
+ */
+inline validate_fun choose_validator() {
+#ifdef STATICLIB_WEBSOCKET_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return validate_avx2;
+    }
+#endif // STATICLIB_WEBSOCKET_AVX2
+    return nullptr;
+}
+
+} // namespace
+
+/**
+ * Streaming UTF-8 validator, input can be split at any position
+ * (including the middle of a code point), state is kept between calls.
+ * Runs of ASCII characters are skipped 16 (or 8) bytes at a time.
+ * When AVX2 is available on the current CPU (selected once at runtime)
+ * non-ASCII input is validated 32 bytes at a time with the nibble lookup
+ * classifier, otherwise complete multibyte sequences are checked directly.
+ * Table-driven DFA is used for sequences split between chunks.
+ */
+class utf8_validator {
+    /**
+     * DFA state
+     */
+    uint8_t state = detail_utf8::state_accept;
+
+public:
+    /**
+     * Validates next chunk of input
+     *
+     * @param data input chunk
+     * @return `false` if invalid input was found, `true` otherwise
+     */
+    bool update(sl::io::span<const char> data) {
+        auto classes = detail_utf8::byte_classes();
+        auto trans = detail_utf8::transitions();
+        auto st = state;
+        size_t pos = 0;
+        while (pos < data.size() && detail_utf8::state_reject != st) {
+            auto byte = static_cast<uint8_t>(data[pos]);
+            if (detail_utf8::state_accept == st) {
+                if (byte < 0x80) {
+                    pos = detail_utf8::skip_ascii(data.data(), pos, data.size());
+                    continue;
+                }
+                static const detail_utf8::validate_fun kernel = detail_utf8::choose_validator();
+                if (nullptr != kernel && data.size() - pos >= detail_utf8::simd_threshold) {
+                    // sequence cut by the end of chunk is left for DFA
+                    auto end = detail_utf8::last_boundary(data.data(), pos, data.size());
+                    if (!kernel(data.data() + pos, end - pos)) {
+                        st = detail_utf8::state_reject;
+                        break;
+                    }
+                    pos = end;
+                    continue;
+                }
+                if (pos + 4 <= data.size()) {
+                    auto len = detail_utf8::check_sequence(data.data() + pos);
+                    if (0 == len) {
+                        st = detail_utf8::state_reject;
+                        break;
+                    }
+                    pos += len;
+                    continue;
+                }
+            }
+            // chunk boundary or continuation of the previous chunk
+            st = trans[st + classes[byte]];
+            pos += 1;
+        }
+        this->state = st;
+        return detail_utf8::state_reject != st;
+    }
+
+    /**
+     * Flag shows whether no invalid input was found so far
+     *
+     * @return `false` if invalid input was found, `true` otherwise
+     */
+    bool is_valid() const {
+        return detail_utf8::state_reject != state;
+    }
+
+    /**
+     * Flag shows whether input validated so far is a complete valid
+     * UTF-8 string (doesn't end in the middle of a code point), should
+     * be checked at the end of the message
+     *
+     * @return whether input is complete and valid
+     */
+    bool is_complete() const {
+        return detail_utf8::state_accept == state;
+    }
+
+    /**
+     * Resets the validator to be used for the next message
+     */
+    void reset() {
+        this->state = detail_utf8::state_accept;
+    }
+};
+
+namespace detail_utf8 {
+
+/**
+ * Size of the block that is unmasked and then validated
+ * while it is still in L1 cache
+ */
+const size_t fused_block_size = 1024;
+
+/**
+ * Unmasks a single block, mask pattern must be rotated to the block phase
+ *
+ * @return `true` if block contains only ASCII characters
+ */
+#ifdef STATICLIB_WEBSOCKET_SSE2
+inline bool unmask_block(const char* src, char* dest, __m128i pattern) {
+    __m128i acc = _mm_setzero_si128();
+    for (size_t i = 0; i < fused_block_size; i += 16) {
+        __m128i vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        vec = _mm_xor_si128(vec, pattern);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), vec);
+        acc = _mm_or_si128(acc, vec);
+    }
+    return 0 == _mm_movemask_epi8(acc);
+}
+#else
+inline bool unmask_block(const char* src, char* dest, uint64_t pattern) {
+    uint64_t acc = 0;
+    for (size_t i = 0; i < fused_block_size; i += 8) {
+        uint64_t word = 0;
+        std::memcpy(std::addressof(word), src + i, sizeof(word));
+        word ^= pattern;
+        std::memcpy(dest + i, std::addressof(word), sizeof(word));
+        acc |= word;
+    }
+    return 0 == (acc & 0x8080808080808080ULL);
+}
+#endif // STATICLIB_WEBSOCKET_SSE2
+
+} // namespace
+
+/**
+ * Unmasks the data into dest buffer and validates it as UTF-8 in a single
+ * pass: data is processed in small blocks, each block is validated right after
+ * unmasking while it is in L1 cache, validation of ASCII-only blocks is done
+ * on registers without re-reading the block.
+ *
+ * @param src masked data
+ * @param dest dest buffer, must have at least `len` bytes
+ * @param len number of bytes to process
+ * @param mask mask value as read from the frame header, `0` for unmasked data
+ * @param offset position of the first byte of `src` in the payload
+ * @param validator validator that keeps the state between frames
+ * @return `false` if invalid input was found, `true` otherwise
+ */
+inline bool unmask_and_validate(const char* src, char* dest, size_t len, uint32_t mask, size_t offset,
+        utf8_validator& validator) {
+    auto block = detail_utf8::fused_block_size;
+#ifdef STATICLIB_WEBSOCKET_SSE2
+    char pattern_bytes[16];
+    detail_masking::make_pattern(mask, offset, pattern_bytes, sizeof(pattern_bytes));
+    auto pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern_bytes));
+#else
+    char pattern_bytes[8];
+    detail_masking::make_pattern(mask, offset, pattern_bytes, sizeof(pattern_bytes));
+    uint64_t pattern = 0;
+    std::memcpy(std::addressof(pattern), pattern_bytes, sizeof(pattern));
+#endif // STATICLIB_WEBSOCKET_SSE2
+    size_t idx = 0;
+    // phase does not change after each block
+    for (; idx + block <= len; idx += block) {
+        bool ascii = detail_utf8::unmask_block(src + idx, dest + idx, pattern);
+        if (!(ascii && validator.is_complete())) {
+            validator.update({dest + idx, block});
+        }
+    }
+    if (idx < len) {
+        apply_mask(src + idx, dest + idx, len - idx, mask, offset + idx);
+        validator.update({dest + idx, len - idx});
+    }
+    return validator.is_valid();
+}
+
+/**
+ * `Sink` wrapper that validates all data passing through it as UTF-8,
+ * validation result is available from the specified validator
+ */
+template<typename Sink>
+class utf8_validating_sink {
+    /**
+     * Destination sink
+     */
+    Sink sink;
+    /**
+     * Validator
+     */
+    utf8_validator* validator;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param sink destination sink
+     * @param validator_ref validator that keeps the state between frames
+     */
+    utf8_validating_sink(Sink&& sink, utf8_validator& validator_ref) :
+    sink(std::move(sink)),
+    validator(std::addressof(validator_ref)) { }
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    utf8_validating_sink(const utf8_validating_sink&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    utf8_validating_sink& operator=(const utf8_validating_sink&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    utf8_validating_sink(utf8_validating_sink&& other) :
+    sink(std::move(other.sink)),
+    validator(other.validator) { }
+
+    /**
+     * Validating write implementation
+     *
+     * @param span buffer span
+     * @return number of bytes processed
+     */
+    std::streamsize write(sl::io::span<const char> span) {
+        validator->update(span);
+        sl::io::write_all(sink, span);
+        return static_cast<std::streamsize>(span.size());
+    }
+
+    /**
+     * Flushes destination sink
+     *
+     * @return number of bytes flushed
+     */
+    std::streamsize flush() {
+        return sink.flush();
+    }
+
+    /**
+     * Underlying sink accessor
+     *
+     * @return underlying sink reference
+     */
+    Sink& get_sink() {
+        return sink;
+    }
+};
+
+/**
+ * Factory function for creating validating sinks,
+ * created sink will own the destination sink
+ *
+ * @param sink destination sink
+ * @param validator validator that keeps the state between frames
+ * @return validating sink
+ */
+template<typename Sink,
+        class = typename std::enable_if<!std::is_lvalue_reference<Sink>::value>::type>
+utf8_validating_sink<Sink> make_utf8_validating_sink(Sink&& sink, utf8_validator& validator) {
+    return utf8_validating_sink<Sink>(std::move(sink), validator);
+}
+
+/**
+ * Factory function for creating validating sinks,
+ * created sink will NOT own the destination sink
+ *
+ * @param sink destination sink
+ * @param validator validator that keeps the state between frames
+ * @return validating sink
+ */
+template<typename Sink>
+utf8_validating_sink<sl::io::reference_sink<Sink>> make_utf8_validating_sink(Sink& sink,
+        utf8_validator& validator) {
+    return utf8_validating_sink<sl::io::reference_sink<Sink>>(
+            sl::io::make_reference_sink(sink), validator);
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_UTF8_VALIDATOR_HPP */
@@ -0,0 +1,278 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   vectored_encoder.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_VECTORED_ENCODER_HPP
+#define STATICLIB_WEBSOCKET_VECTORED_ENCODER_HPP
+
+#include <cstdint>
+#include <array>
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/uio.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_type.hpp"
+#include "staticlib/websocket/websocket_exception.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Scatter/gather encoder for outgoing (unmasked, server-side) frames.
+ * Frame headers are written into the internal fixed-size storage, payloads
+ * are referenced without copying and must stay alive and unchanged until
+ * all the data is written out. Resulting list of buffers can be passed
+ * to `writev`/`sendmsg` as is, partial writes are handled with `consume`.
+ *
+ * Encoder is neither copyable nor movable, segments point
+ * into the header storage of this instance.
+ *
+ * @tparam MaxFrames max number of frames that can be queued
+ */
+template<size_t MaxFrames = 64>
+class vectored_encoder {
+    /**
+     * Reference to the header or to the payload bytes
+     */
+    struct buffer_ref {
+        const char* data = nullptr;
+        size_t len = 0;
+    };
+
+    std::array<std::array<char, 10>, MaxFrames> headers;
+    std::array<buffer_ref, MaxFrames * 2> segments;
+    size_t frames_count = 0;
+    size_t segments_count = 0;
+    size_t first_segment = 0;
+    size_t pending_bytes = 0;
+
+public:
+    /**
+     * Constructor
+     */
+    vectored_encoder() { }
+
+    /**
+     * Deleted copy constructor
+     */
+    vectored_encoder(const vectored_encoder&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    vectored_encoder& operator=(const vectored_encoder&) = delete;
+
+    /**
+     * Adds a single frame
+     *
+     * @param fr_type frame type
+     * @param payload frame payload, referenced without copying
+     * @param final whether FIN bit should be set
+     * @param compressed whether RSV1 bit should be set (permessage-deflate)
+     * @return `false` if there is no space left for this frame
+     */
+    bool add(frame_type fr_type, sl::io::span<const char> payload,
+            bool final = true, bool compressed = false) {
+        if (frames_count >= MaxFrames) {
+            return false;
+        }
+        auto& hbuf = headers[frames_count];
+        auto header = frame::make_header(hbuf, fr_type, payload.size(), false, !final, compressed);
+        frames_count += 1;
+        push_segment(header.data(), header.size());
+        if (payload.size() > 0) {
+            push_segment(payload.data(), payload.size());
+        }
+        return true;
+    }
+
+    /**
+     * Adds an already encoded frame (for example, shared `encoded_frame`
+     * bytes), frame is referenced without copying
+     *
+     * @param encoded encoded frame bytes (header followed by payload)
+     * @return `false` if there is no space left for this frame
+     */
+    bool add_encoded(sl::io::span<const char> encoded) {
+        if (frames_count >= MaxFrames) {
+            return false;
+        }
+        frames_count += 1;
+        push_segment(encoded.data(), encoded.size());
+        return true;
+    }
+
+    /**
+     * Adds a message split into fragments of the specified size,
+     * message is added either completely or not at all
+     *
+     * @param fr_type message type (`text` or `binary`)
+     * @param payload message payload, referenced without copying
+     * @param fragment_size max size of the payload of each fragment
+     * @param compressed whether RSV1 bit should be set on the first fragment (permessage-deflate)
+     * @return `false` if there is no space left for all the fragments
+     */
+    bool add_fragmented(frame_type fr_type, sl::io::span<const char> payload,
+            size_t fragment_size, bool compressed = false) {
+        if (0 == fragment_size) {
+            throw websocket_exception(TRACEMSG("Invalid zero fragment size specified"));
+        }
+        size_t count = payload.size() > 0 ? (payload.size() + fragment_size - 1) / fragment_size : 1;
+        if (count > MaxFrames - frames_count) {
+            return false;
+        }
+        size_t idx = 0;
+        for (size_t i = 0; i < count; i++) {
+            size_t len = payload.size() - idx < fragment_size ? payload.size() - idx : fragment_size;
+            auto ft = 0 == i ? fr_type : frame_type::continuation;
+            add(ft, sl::io::make_span(payload.data() + idx, len), count - 1 == i, 0 == i && compressed);
+            idx += len;
+        }
+        return true;
+    }
+
+    /**
+     * Marks the specified number of bytes as written, fully written
+     * segments are dropped from the list, partially written segment
+     * is adjusted; encoder is reset when all data is written
+     *
+     * @param written number of bytes written by `writev`/`sendmsg`
+     */
+    void consume(size_t written) {
+        if (written > pending_bytes) {
+            throw websocket_exception(TRACEMSG("Invalid written bytes count specified,"
+                    " written: [" + sl::support::to_string(written) + "]," +
+                    " pending: [" + sl::support::to_string(pending_bytes) + "]"));
+        }
+        pending_bytes -= written;
+        while (written > 0) {
+            auto& seg = segments[first_segment];
+            if (written < seg.len) {
+                seg.data += written;
+                seg.len -= written;
+                written = 0;
+            } else {
+                written -= seg.len;
+                first_segment += 1;
+            }
+        }
+        if (0 == pending_bytes) {
+            clear();
+        }
+    }
+
+    /**
+     * Drops all queued frames
+     */
+    void clear() {
+        frames_count = 0;
+        segments_count = 0;
+        first_segment = 0;
+        pending_bytes = 0;
+    }
+
+    /**
+     * Number of pending segments
+     *
+     * @return number of pending segments
+     */
+    size_t count() const {
+        return segments_count - first_segment;
+    }
+
+    /**
+     * Pending segment at the specified index
+     *
+     * @param idx segment index, must be less than `count()`
+     * @return segment bytes
+     */
+    sl::io::span<const char> segment(size_t idx) const {
+        auto& seg = segments[first_segment + idx];
+        return sl::io::make_span(seg.data, seg.len);
+    }
+
+    /**
+     * Total number of pending bytes
+     *
+     * @return number of pending bytes
+     */
+    size_t size() const {
+        return pending_bytes;
+    }
+
+    /**
+     * Checks whether there is pending data
+     *
+     * @return `true` if all data is written
+     */
+    bool empty() const {
+        return 0 == pending_bytes;
+    }
+
+    /**
+     * Number of frames that can still be added
+     *
+     * @return number of free frame slots
+     */
+    size_t frames_available() const {
+        return MaxFrames - frames_count;
+    }
+
+#ifndef STATICLIB_WINDOWS
+    /**
+     * Fills the specified array with pending segments in a form
+     * suitable for `writev`/`sendmsg`
+     *
+     * @param dest dest array
+     * @param dest_len number of elements in dest array
+     * @return number of elements filled
+     */
+    size_t to_iovec(struct iovec* dest, size_t dest_len) const {
+        size_t len = count() < dest_len ? count() : dest_len;
+        for (size_t i = 0; i < len; i++) {
+            auto& seg = segments[first_segment + i];
+            dest[i].iov_base = const_cast<char*>(seg.data);
+            dest[i].iov_len = seg.len;
+        }
+        return len;
+    }
+#endif // !STATICLIB_WINDOWS
+
+private:
+    void push_segment(const char* data, size_t len) {
+        auto& seg = segments[segments_count];
+        seg.data = data;
+        seg.len = len;
+        segments_count += 1;
+        pending_bytes += len;
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_VECTORED_ENCODER_HPP */
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   websocket_exception.hpp
+ */
+
+#ifndef STATICLIB_WEBSOCKET_WEBSOCKET_EXCEPTION_HPP
+#define STATICLIB_WEBSOCKET_WEBSOCKET_EXCEPTION_HPP
+
+#include <string>
+
+#include "staticlib/support.hpp"
+
+namespace staticlib {
+namespace websocket {
+
+/**
+ * Module specific exception
+ */
+class websocket_exception : public sl::support::exception {
+public:
+    /**
+     * Default constructor
+     */
+    websocket_exception() = default;
+
+    /**
+     * Constructor with message
+     * 
+     * @param msg error message
+     */
+    websocket_exception(const std::string& msg) :
+    sl::support::exception(msg) { }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_WEBSOCKET_WEBSOCKET_EXCEPTION_HPP */
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   broadcast_hub_test.cpp
+ */
+
+#include "staticlib/websocket/broadcast_hub.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/vectored_encoder.hpp"
+
+typedef std::shared_ptr<const sl::websocket::encoded_frame> frame_ptr;
+
+void test_encoded_frame() {
+    auto msg = std::string("hello");
+    auto fr = sl::websocket::make_encoded_frame(sl::websocket::frame_type::text, msg);
+    slassert(sl::websocket::frame_type::text == fr->type());
+    slassert(7 == fr->size());
+    slassert(2 == fr->header().size());
+    slassert(msg == std::string(fr->payload().data(), fr->payload().size()));
+    auto parsed = sl::websocket::frame(fr->data());
+    slassert(parsed.is_well_formed());
+    slassert(parsed.is_complete());
+    slassert(parsed.is_final());
+    slassert(sl::websocket::frame_type::text == parsed.type());
+    slassert(5 == parsed.payload_length());
+}
+
+void test_publish() {
+    sl::websocket::broadcast_hub<int> hub;
+    slassert(hub.subscribe("quotes", 1));
+    slassert(hub.subscribe("quotes", 2));
+    slassert(!hub.subscribe("quotes", 2));
+    slassert(hub.subscribe("trades", 2));
+    slassert(2 == hub.subscribers_count("quotes"));
+    slassert(2 == hub.topics_count());
+
+    auto queues = std::vector<std::vector<frame_ptr>>(3);
+    auto deliver = [&queues](int sub, const frame_ptr& fr) {
+        queues[static_cast<size_t>(sub)].push_back(fr);
+    };
+    auto msg = std::string("EURUSD 1.1675");
+    slassert(2 == hub.publish("quotes", sl::websocket::frame_type::text, msg, deliver));
+    slassert(0 == hub.publish("unknown", sl::websocket::frame_type::text, msg, deliver));
+    slassert(1 == queues[1].size());
+    slassert(1 == queues[2].size());
+    // encoded once, shared by all recipients
+    slassert(queues[1][0].get() == queues[2][0].get());
+    slassert(2 == queues[1][0].use_count());
+
+    slassert(hub.unsubscribe("quotes", 1));
+    slassert(!hub.unsubscribe("quotes", 1));
+    slassert(1 == hub.subscribers_count("quotes"));
+    slassert(2 == hub.unsubscribe_all(2));
+    slassert(0 == hub.subscribers_count("quotes"));
+    slassert(0 == hub.topics_count());
+}
+
+void test_unsubscribe() {
+    sl::websocket::broadcast_hub<int> hub;
+    for (int i = 0; i < 1000; i++) {
+        slassert(hub.subscribe("quotes", i));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        slassert(hub.unsubscribe("quotes", i));
+    }
+    slassert(500 == hub.subscribers_count("quotes"));
+    auto received = std::vector<int>(1000);
+    auto msg = std::string("EURUSD 1.1675");
+    // subscribers leave while the frame is being delivered
+    slassert(500 == hub.publish("quotes", sl::websocket::frame_type::text, msg,
+            [&](int sub, const frame_ptr&) {
+                received[static_cast<size_t>(sub)] += 1;
+                slassert(1 == hub.unsubscribe_all(sub));
+                if (sub < 10) {
+                    hub.subscribe("quotes", sub + 1000);
+                }
+            }));
+    for (int i = 0; i < 1000; i++) {
+        slassert((1 == i % 2 ? 1 : 0) == received[static_cast<size_t>(i)]);
+    }
+    // only the subscribers added during delivery are left
+    slassert(5 == hub.subscribers_count("quotes"));
+    // changes are applied in order after the outermost publish
+    size_t nested = 0;
+    slassert(5 == hub.publish("quotes", sl::websocket::frame_type::text, msg,
+            [&](int sub, const frame_ptr&) {
+                slassert(hub.unsubscribe("quotes", sub));
+                slassert(hub.subscribe("quotes", sub));
+                nested += hub.publish("quotes", sl::websocket::frame_type::text, msg,
+                        [](int, const frame_ptr&) { });
+            }));
+    slassert(25 == nested);
+    slassert(5 == hub.subscribers_count("quotes"));
+    slassert(1 == hub.unsubscribe_all(1001));
+    slassert(4 == hub.subscribers_count("quotes"));
+}
+
+void test_vectored() {
+    auto fr = sl::websocket::make_encoded_frame(sl::websocket::frame_type::binary, std::string("data"));
+    sl::websocket::vectored_encoder<4> enc;
+    slassert(enc.add_encoded(fr->data()));
+    slassert(enc.add_encoded(fr->data()));
+    slassert(2 == enc.count());
+    slassert(fr->data().data() == enc.segment(0).data());
+    slassert(2 * fr->size() == enc.size());
+}
+
+int main() {
+    try {
+        test_encoded_frame();
+        test_publish();
+        test_unsubscribe();
+        test_vectored();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
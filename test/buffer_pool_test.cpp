@@ -0,0 +1,192 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   buffer_pool_test.cpp
+ */
+
+#include "staticlib/websocket/buffer_pool.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/websocket/encoded_frame.hpp"
+#include "staticlib/websocket/frame.hpp"
+
+void test_classes() {
+    sl::websocket::buffer_pool pool;
+    slassert(sl::websocket::buffer_class::small == pool.classify(0));
+    slassert(sl::websocket::buffer_class::small == pool.classify(125 + 14));
+    slassert(sl::websocket::buffer_class::medium == pool.classify(257));
+    slassert(sl::websocket::buffer_class::medium == pool.classify(65535 + 14));
+    slassert(sl::websocket::buffer_class::large == pool.classify(65536 + 65));
+    slassert(sl::websocket::buffer_class::large == pool.classify(1 << 20));
+    slassert(sl::websocket::buffer_class::oversize == pool.classify((1 << 20) + 1));
+    slassert(256 == pool.buffer_size(sl::websocket::buffer_class::small));
+
+    bool thrown = false;
+    try {
+        auto conf = sl::websocket::buffer_pool_config();
+        conf.large_buffer_size = 4096;
+        sl::websocket::buffer_pool invalid(conf);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_pool() {
+    auto conf = sl::websocket::buffer_pool_config();
+    conf.slab_size = 4096;
+    sl::websocket::buffer_pool pool(conf);
+    slassert(0 == pool.reserved_bytes());
+    {
+        auto buf = pool.acquire(100);
+        slassert(nullptr != buf.data());
+        slassert(100 == buf.size());
+        slassert(256 == buf.capacity());
+        std::memset(buf.data(), 'a', buf.capacity());
+        auto st = pool.stats(sl::websocket::buffer_class::small);
+        slassert(1 == st.slabs);
+        slassert(16 == st.capacity);
+        slassert(15 == st.free);
+        slassert(1 == st.in_use);
+        // buffers are carved from the same slab
+        auto buf2 = pool.acquire(10);
+        slassert(256 == buf2.data() - buf.data());
+        // moved buffer is released once
+        auto moved = std::move(buf2);
+        slassert(nullptr == buf2.data());
+        slassert(2 == pool.stats(sl::websocket::buffer_class::small).in_use);
+    }
+    slassert(0 == pool.stats(sl::websocket::buffer_class::small).in_use);
+    slassert(16 == pool.stats(sl::websocket::buffer_class::small).free);
+    // slab grows
+    auto bufs = std::vector<sl::websocket::pooled_buffer>();
+    for (size_t i = 0; i < 20; i++) {
+        bufs.emplace_back(pool.acquire(125));
+    }
+    slassert(2 == pool.stats(sl::websocket::buffer_class::small).slabs);
+    bufs.clear();
+    slassert(32 == pool.stats(sl::websocket::buffer_class::small).free);
+    // medium slab holds at least one buffer
+    auto med = pool.acquire(4000);
+    slassert(sl::websocket::buffer_class::medium == med.size_class());
+    slassert(1 == pool.stats(sl::websocket::buffer_class::medium).capacity);
+    // oversize
+    {
+        auto big = pool.acquire((1 << 20) + 1);
+        slassert(sl::websocket::buffer_class::oversize == big.size_class());
+        slassert(1 == pool.oversize_in_use());
+        big.data()[(1 << 20)] = 'a';
+    }
+    slassert(0 == pool.oversize_in_use());
+}
+
+void test_cache() {
+    sl::websocket::buffer_pool pool;
+    {
+        sl::websocket::buffer_cache cache(pool, 8);
+        auto bufs = std::vector<sl::websocket::pooled_buffer>();
+        // refilled in batches of 4
+        bufs.emplace_back(cache.acquire(10));
+        slassert(3 == cache.cached_count(sl::websocket::buffer_class::small));
+        auto st = pool.stats(sl::websocket::buffer_class::small);
+        slassert(3 == st.cached);
+        slassert(1 == st.in_use);
+        for (size_t i = 0; i < 15; i++) {
+            bufs.emplace_back(cache.acquire(10));
+        }
+        slassert(16 == pool.stats(sl::websocket::buffer_class::small).in_use);
+        // excess is returned to pool
+        bufs.clear();
+        slassert(cache.cached_count(sl::websocket::buffer_class::small) <= 8);
+        st = pool.stats(sl::websocket::buffer_class::small);
+        slassert(0 == st.in_use);
+        slassert(st.capacity == st.free + st.cached);
+    }
+    auto st = pool.stats(sl::websocket::buffer_class::small);
+    slassert(0 == st.cached);
+    slassert(st.capacity == st.free);
+}
+
+void test_threads() {
+    sl::websocket::buffer_pool pool;
+    auto threads = std::vector<std::thread>();
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([&pool, t] {
+            sl::websocket::buffer_cache cache(pool, 16);
+            for (size_t i = 0; i < 10000; i++) {
+                auto size = 0 == i % 10 ? 1000 : 100;
+                auto buf = cache.acquire(size);
+                std::memset(buf.data(), static_cast<int>(t), buf.size());
+                // shared frames are released to the pool directly
+                auto other = pool.acquire(size);
+                std::memcpy(other.data(), buf.data(), buf.size());
+                slassert(0 == std::memcmp(other.data(), buf.data(), buf.size()));
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(0 == pool.stats(sl::websocket::buffer_class::small).in_use);
+    slassert(0 == pool.stats(sl::websocket::buffer_class::medium).in_use);
+}
+
+void test_huge_pages() {
+    auto conf = sl::websocket::buffer_pool_config();
+    conf.huge_pages = true;
+    sl::websocket::buffer_pool pool(conf);
+    auto buf = pool.acquire(65536);
+    std::memset(buf.data(), 'a', buf.capacity());
+    slassert(pool.reserved_bytes() >= buf.capacity());
+}
+
+void test_encoded_frame() {
+    sl::websocket::buffer_pool pool;
+    auto msg = std::string("hello");
+    {
+        auto fr = sl::websocket::make_encoded_frame(pool, sl::websocket::frame_type::text, {msg.data(), msg.length()});
+        slassert(7 == fr->size());
+        slassert(msg == std::string(fr->payload().data(), fr->payload().size()));
+        auto data = fr->data();
+        auto parsed = sl::websocket::frame({data.data(), data.size()});
+        slassert(parsed.is_complete());
+        slassert(sl::websocket::frame_type::text == parsed.type());
+        slassert(1 == pool.stats(sl::websocket::buffer_class::small).in_use);
+    }
+    slassert(0 == pool.stats(sl::websocket::buffer_class::small).in_use);
+}
+
+int main() {
+    try {
+        test_classes();
+        test_pool();
+        test_cache();
+        test_threads();
+        test_huge_pages();
+        test_encoded_frame();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   control_frames_test.cpp
+ */
+
+#include "staticlib/websocket/control_frames.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+namespace ctl = sl::websocket::control;
+
+void test_close_codes() {
+    slassert(ctl::is_valid_close_code(1000));
+    slassert(ctl::is_valid_close_code(1011));
+    slassert(ctl::is_valid_close_code(3000));
+    slassert(ctl::is_valid_close_code(4999));
+    slassert(!ctl::is_valid_close_code(999));
+    slassert(!ctl::is_valid_close_code(1004));
+    slassert(!ctl::is_valid_close_code(1005));
+    slassert(!ctl::is_valid_close_code(1006));
+    slassert(!ctl::is_valid_close_code(1015));
+    slassert(!ctl::is_valid_close_code(2999));
+    slassert(!ctl::is_valid_close_code(5000));
+}
+
+void test_close_payload() {
+    auto buf = std::array<char, 125>();
+    auto pl = ctl::make_close_payload(buf, ctl::close_going_away, std::string("bye"));
+    slassert("03e9627965" == sl::io::string_to_hex(pl));
+    uint16_t code = 0;
+    auto reason = sl::io::span<const char>(nullptr, 0);
+    slassert(ctl::close_status::ok == ctl::parse_close(pl, code, reason));
+    slassert(ctl::close_going_away == code);
+    slassert("bye" == std::string(reason.data(), reason.size()));
+    // empty
+    slassert(ctl::close_status::empty == ctl::parse_close({nullptr, 0}, code, reason));
+    slassert(ctl::close_no_status == code);
+    // invalid
+    slassert(ctl::close_status::invalid == ctl::parse_close(sl::io::string_from_hex("03"), code, reason));
+    slassert(ctl::close_status::invalid == ctl::parse_close(sl::io::string_from_hex("03ed"), code, reason));
+    slassert(ctl::close_status::invalid == ctl::parse_close(sl::io::string_from_hex("03e8c0af"), code, reason));
+    bool thrown = false;
+    try {
+        ctl::make_close_payload(buf, ctl::close_no_status);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_canned() {
+    slassert("8900" == sl::io::string_to_hex(ctl::ping_frame()));
+    slassert("8a00" == sl::io::string_to_hex(ctl::pong_frame()));
+    slassert("880203e8" == sl::io::string_to_hex(ctl::close_normal_frame()));
+    slassert("880203e9" == sl::io::string_to_hex(ctl::close_going_away_frame()));
+    auto fr = sl::websocket::frame(ctl::close_normal_frame());
+    slassert(fr.is_complete());
+    slassert(sl::websocket::frame_type::close == fr.type());
+}
+
+void test_pong() {
+    // masked "Hello" ping from RFC 6455 5.7
+    auto ping_data = sl::io::string_from_hex("898537fa213d7f9f4d5158");
+    auto ping = sl::websocket::frame(ping_data);
+    auto buf = std::array<char, 127>();
+    auto pong = ctl::make_pong(buf, ping);
+    slassert("8a0548656c6c6f" == sl::io::string_to_hex(pong));
+    // unmasked ping
+    auto ping_plain_data = sl::io::string_from_hex("890548656c6c6f");
+    auto ping_plain = sl::websocket::frame(ping_plain_data);
+    slassert("8a0548656c6c6f" == sl::io::string_to_hex(ctl::make_pong(buf, ping_plain)));
+    // client-side masked pong
+    auto buf_masked = std::array<char, 131>();
+    auto pong_masked = ctl::make_pong(buf_masked, ping_plain, 0x37fa213d);
+    slassert("8a8537fa213d7f9f4d5158" == sl::io::string_to_hex(pong_masked));
+    // not a ping
+    auto text = sl::io::string_from_hex("810548656c6c6f");
+    auto text_frame = sl::websocket::frame(text);
+    bool thrown = false;
+    try {
+        ctl::make_pong(buf, text_frame);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_close_codes();
+        test_close_payload();
+        test_canned();
+        test_pong();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
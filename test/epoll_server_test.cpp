@@ -0,0 +1,297 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   epoll_server_test.cpp
+ */
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_LINUX
+
+#include "staticlib/websocket/epoll_server.hpp"
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/masked_payload_sink.hpp"
+
+const uint32_t mask = 0x1875fdc8;
+
+class echo_handler {
+public:
+    std::atomic<size_t> opened{0};
+    std::atomic<size_t> closed{0};
+    std::atomic<uint16_t> last_code{0};
+
+    std::string target;
+
+    void on_open(sl::websocket::epoll_connection& conn) {
+        auto& req = conn.handshake_request();
+        this->target = std::string(req.target.data(), req.target.size());
+        opened += 1;
+    }
+
+    void on_message(sl::websocket::epoll_connection& conn, sl::websocket::frame_type type,
+            sl::io::span<const char> payload) {
+        if (0 == std::string(payload.data(), payload.size()).find("shared")) {
+            // shared frame between the copied ones keeps its place in the queue
+            auto fr = sl::websocket::make_encoded_frame(type, payload);
+            conn.send(type, sl::io::make_span("a", 1));
+            conn.send(fr);
+            conn.send(type, sl::io::make_span("b", 1));
+            conn.send(fr);
+        } else {
+            conn.send(type, payload);
+        }
+    }
+
+    void on_close(sl::websocket::epoll_connection&, uint16_t code) {
+        last_code = code;
+        closed += 1;
+    }
+};
+
+class client {
+    int fd;
+
+public:
+    client(uint16_t port) {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        slassert(-1 != fd);
+        struct timeval tv;
+        tv.tv_sec = 5;
+        tv.tv_usec = 0;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, std::addressof(tv), sizeof(tv));
+        struct sockaddr_in addr;
+        std::memset(std::addressof(addr), '\0', sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        slassert(0 == ::connect(fd, reinterpret_cast<struct sockaddr*>(std::addressof(addr)), sizeof(addr)));
+    }
+
+    ~client() {
+        ::close(fd);
+    }
+
+    void write(const std::string& data) {
+        slassert(static_cast<ssize_t>(data.length()) == ::send(fd, data.data(), data.length(), MSG_NOSIGNAL));
+    }
+
+    std::string read(size_t len) {
+        auto res = std::string();
+        while (res.length() < len) {
+            auto buf = std::array<char, 4096>();
+            auto read = ::recv(fd, buf.data(), std::min(buf.size(), len - res.length()), 0);
+            if (read <= 0) {
+                break;
+            }
+            res.append(buf.data(), static_cast<size_t>(read));
+        }
+        return res;
+    }
+
+    std::string read_head() {
+        auto res = std::string();
+        while (std::string::npos == res.find("\r\n\r\n")) {
+            auto part = read(1);
+            if (part.empty()) {
+                break;
+            }
+            res += part;
+        }
+        return res;
+    }
+
+    bool is_eof() {
+        char ch;
+        return 0 == ::recv(fd, std::addressof(ch), 1, 0);
+    }
+};
+
+std::string make_frame(sl::websocket::frame_type ft, const std::string& payload, bool final = true) {
+    auto buf = std::array<char, 14>();
+    auto head = sl::websocket::frame_encoder<sl::websocket::client_role>::make_header(buf, ft,
+            payload.length(), mask, final);
+    auto sink = sl::io::string_sink();
+    sink.write(head);
+    auto masker = sl::websocket::make_masked_payload_sink(sink, mask);
+    masker.write({payload.data(), payload.length()});
+    return sink.get_string();
+}
+
+const std::string request = std::string() +
+        "GET /chat HTTP/1.1\r\n" +
+        "Host: localhost\r\n" +
+        "Upgrade: websocket\r\n" +
+        "Connection: Upgrade\r\n" +
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n" +
+        "Sec-WebSocket-Version: 13\r\n" +
+        "\r\n";
+
+sl::websocket::epoll_server_config make_config() {
+    auto conf = sl::websocket::epoll_server_config();
+    conf.address = "127.0.0.1";
+    conf.port = 0;
+    conf.threads = 2;
+    conf.tick_ms = 50;
+    return conf;
+}
+
+void open(client& cl) {
+    cl.write(request);
+    auto head = cl.read_head();
+    slassert(0 == head.find("HTTP/1.1 101 Switching Protocols\r\n"));
+    slassert(std::string::npos != head.find("s3pPLMBiTxaQ9kYGzzhZRbK+xOo="));
+}
+
+void test_echo() {
+    echo_handler handler;
+    sl::websocket::epoll_server<echo_handler> server(make_config(), handler);
+    server.start();
+    slassert(server.port() > 0);
+    {
+        client cl(server.port());
+        open(cl);
+        // unfragmented, sent byte by byte to check partial frames
+        auto hello = make_frame(sl::websocket::frame_type::text, "Hello");
+        for (char ch : hello) {
+            cl.write(std::string(1, ch));
+        }
+        slassert("\x81\x05Hello" == cl.read(7));
+        // fragmented with ping in the middle
+        cl.write(make_frame(sl::websocket::frame_type::binary, "foo", false) +
+                make_frame(sl::websocket::frame_type::ping, "ka") +
+                make_frame(sl::websocket::frame_type::continuation, "bar"));
+        slassert("\x8a\x02ka" == cl.read(4));
+        slassert("\x82\x06" "foobar" == cl.read(8));
+        // close
+        cl.write(make_frame(sl::websocket::frame_type::close, std::string("\x03\xe8", 2)));
+        slassert("\x88\x02\x03\xe8" == cl.read(4));
+        slassert(cl.is_eof());
+    }
+    server.stop();
+    slassert(1 == handler.opened);
+    slassert("/chat" == handler.target);
+    slassert(1 == handler.closed);
+    slassert(1000 == handler.last_code);
+}
+
+void test_protocol_error() {
+    echo_handler handler;
+    sl::websocket::epoll_server<echo_handler> server(make_config(), handler);
+    server.start();
+    {
+        client cl(server.port());
+        open(cl);
+        // unmasked frame from client
+        cl.write(sl::io::string_from_hex("810548656c6c6f"));
+        slassert("\x88\x02\x03\xea" == cl.read(4));
+        cl.write(make_frame(sl::websocket::frame_type::close, std::string("\x03\xea", 2)));
+        slassert(cl.is_eof());
+    }
+    {
+        client cl(server.port());
+        cl.write("GET / HTTP/1.1\r\nHost: localhost\r\n\r\n");
+        slassert(0 == cl.read_head().find("HTTP/1.1 400 Bad Request\r\n"));
+        slassert(cl.is_eof());
+    }
+    server.stop();
+    slassert(1 == handler.opened);
+    slassert(1002 == handler.last_code);
+}
+
+void test_empty_close() {
+    echo_handler handler;
+    sl::websocket::epoll_server<echo_handler> server(make_config(), handler);
+    server.start();
+    {
+        client cl(server.port());
+        open(cl);
+        // close without status code is valid, RFC 6455 5.5.1
+        cl.write(make_frame(sl::websocket::frame_type::close, ""));
+        slassert(std::string("\x88\x00", 2) == cl.read(2));
+        slassert(cl.is_eof());
+    }
+    server.stop();
+    slassert(1 == handler.closed);
+    slassert(sl::websocket::control::close_no_status == handler.last_code);
+}
+
+void test_shared_frames() {
+    echo_handler handler;
+    sl::websocket::epoll_server<echo_handler> server(make_config(), handler);
+    server.start();
+    {
+        client cl(server.port());
+        open(cl);
+        cl.write(make_frame(sl::websocket::frame_type::text, "shared"));
+        slassert("\x81\x01" "a" "\x81\x06" "shared" "\x81\x01" "b" "\x81\x06" "shared" == cl.read(22));
+        // large frame is written with partial writes
+        auto large = std::string("shared") + std::string(1 << 20, 'x');
+        cl.write(make_frame(sl::websocket::frame_type::binary, large));
+        auto head = std::string("\x82\x7f\x00\x00\x00\x00\x00\x10\x00\x06", 10);
+        auto expected = std::string("\x82\x01" "a") + head + large + "\x82\x01" "b" + head + large;
+        slassert(expected == cl.read(expected.length()));
+    }
+    server.stop();
+}
+
+void test_stop() {
+    echo_handler handler;
+    sl::websocket::epoll_server<echo_handler> server(make_config(), handler);
+    server.start();
+    client cl(server.port());
+    open(cl);
+    server.stop();
+    slassert(cl.is_eof());
+    slassert(1 == handler.closed);
+    slassert(1001 == handler.last_code);
+}
+
+int main() {
+    try {
+        test_echo();
+        test_protocol_error();
+        test_empty_close();
+        test_shared_frames();
+        test_stop();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+#else // !STATICLIB_LINUX
+
+int main() {
+    return 0;
+}
+
+#endif // STATICLIB_LINUX
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   frame_encoder_test.cpp
+ */
+
+#include "staticlib/websocket/frame_encoder.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame_header.hpp"
+
+template<typename Fun>
+bool throws(Fun fun) {
+    try {
+        fun();
+    } catch (const sl::websocket::websocket_exception&) {
+        return true;
+    }
+    return false;
+}
+
+void test_server() {
+    auto buf = std::array<char, 10>();
+    auto head = sl::websocket::frame_encoder<sl::websocket::server_role>::make_header(
+            buf, sl::websocket::frame_type::text, 2);
+    slassert("8102" == sl::io::string_to_hex(head));
+    auto data = std::string(head.data(), head.size()) + "hi";
+    // frame sent by server is accepted by client
+    auto fh = sl::websocket::frame_header();
+    slassert(sl::websocket::header_status::complete ==
+            sl::websocket::frame_header::decode<sl::websocket::client_role>(data, fh, 0));
+    slassert(sl::websocket::header_status::malformed ==
+            sl::websocket::frame_header::decode<sl::websocket::server_role>(data, fh, 0));
+    auto fr = sl::websocket::frame(data);
+    slassert(fr.conforms_to<sl::websocket::client_role>());
+    slassert(!fr.conforms_to<sl::websocket::server_role>());
+    slassert(fr.conforms_to<sl::websocket::any_role>());
+    // fragmented with compression on the first frame
+    head = sl::websocket::frame_encoder<sl::websocket::server_role>::make_header(
+            buf, sl::websocket::frame_type::binary, 2, false, true);
+    slassert("4202" == sl::io::string_to_hex(head));
+}
+
+void test_client() {
+    auto buf = std::array<char, 14>();
+    auto head = sl::websocket::frame_encoder<sl::websocket::client_role>::make_header(
+            buf, sl::websocket::frame_type::text, 2, 0x1875fdc8);
+    slassert("81821875fdc8" == sl::io::string_to_hex(head));
+    auto fh = sl::websocket::frame_header();
+    slassert(sl::websocket::header_status::complete ==
+            sl::websocket::frame_header::decode<sl::websocket::server_role>(head, fh, 0));
+}
+
+void test_invalid() {
+    auto buf = std::array<char, 10>();
+    auto buf14 = std::array<char, 14>();
+    typedef sl::websocket::frame_encoder<sl::websocket::server_role> server_encoder;
+    typedef sl::websocket::frame_encoder<sl::websocket::client_role> client_encoder;
+    slassert(throws([&buf] {
+        server_encoder::make_header(buf, sl::websocket::frame_type::ping, 126);
+    }));
+    slassert(throws([&buf] {
+        server_encoder::make_header(buf, sl::websocket::frame_type::close, 2, false);
+    }));
+    slassert(throws([&buf] {
+        server_encoder::make_header(buf, sl::websocket::frame_type::pong, 2, true, true);
+    }));
+    slassert(throws([&buf] {
+        server_encoder::make_header(buf, sl::websocket::frame_type::continuation, 2, true, true);
+    }));
+    slassert(throws([&buf14] {
+        client_encoder::make_header(buf14, sl::websocket::frame_type::text, 2, 0);
+    }));
+    slassert(!throws([&buf] {
+        server_encoder::make_header(buf, sl::websocket::frame_type::ping, 125);
+    }));
+}
+
+int main() {
+    try {
+        test_server();
+        test_client();
+        test_invalid();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   frame_parser_test.cpp
+ */
+
+#include "staticlib/websocket/frame_parser.hpp"
+
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+const std::string hi = sl::io::string_from_hex("81821875fdc8701c");
+const std::string lorem_128 = sl::io::string_from_hex("81fe0080a2272042ee485227cf074932d1524d62c6484c2dd007532bd607412fc7530c62c1484e31c7445427d6525262c3434932cb54432bcc400027ce4e546e8254452682434f62c74e5531cf484462d6424d32cd55002bcc444926cb43552cd6075536824b4120cd554562c7530026cd4b4f30c7074d23c5494162c34b4933d7460e62f7530027");
+const std::string lorem_128_plain = std::string("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut e");
+
+void test_bytewise() {
+    auto parser = sl::websocket::frame_parser();
+    auto sink = sl::io::string_sink();
+    slassert(2 == parser.bytes_needed());
+    slassert(1 == parser.feed({lorem_128.data(), 1}, sink));
+    slassert(1 == parser.bytes_needed());
+    slassert(1 == parser.feed({lorem_128.data() + 1, 1}, sink));
+    // 16-bit length and mask
+    slassert(6 == parser.bytes_needed());
+    for (size_t i = 2; i < 8; i++) {
+        slassert(!parser.is_header_complete());
+        slassert(1 == parser.feed({lorem_128.data() + i, 1}, sink));
+    }
+    slassert(parser.is_header_complete());
+    slassert(parser.is_final());
+    slassert(parser.is_masked());
+    slassert(sl::websocket::frame_type::text == parser.type());
+    slassert(0xa2272042 == parser.mask_value());
+    slassert(128 == parser.payload_length());
+    slassert(128 == parser.bytes_needed());
+    slassert("81fe0080a2272042" == sl::io::string_to_hex(parser.header()));
+    for (size_t i = 8; i < lorem_128.length(); i++) {
+        slassert(!parser.is_complete());
+        slassert(1 == parser.feed({lorem_128.data() + i, 1}, sink));
+        // payload is streamed before the frame is complete
+        slassert(i - 7 == sink.get_string().length());
+    }
+    slassert(parser.is_complete());
+    slassert(0 == parser.bytes_needed());
+    slassert(lorem_128_plain == sink.get_string());
+}
+
+void test_chunks() {
+    auto data = lorem_128 + hi;
+    auto parser = sl::websocket::frame_parser();
+    auto sink = sl::io::string_sink();
+    size_t pos = 0;
+    pos += parser.feed({data.data(), 5}, sink);
+    slassert(5 == pos);
+    slassert(3 == parser.bytes_needed());
+    pos += parser.feed({data.data() + pos, 100}, sink);
+    slassert(105 == pos);
+    // bytes from the next frame are not consumed
+    pos += parser.feed({data.data() + pos, data.length() - pos}, sink);
+    slassert(lorem_128.length() == pos);
+    slassert(parser.is_complete());
+    slassert(lorem_128_plain == sink.get_string());
+    // next frame
+    parser.reset();
+    auto sink_hi = sl::io::string_sink();
+    pos += parser.feed({data.data() + pos, data.length() - pos}, sink_hi);
+    slassert(data.length() == pos);
+    slassert(parser.is_complete());
+    slassert("hi" == sink_hi.get_string());
+}
+
+void test_in_place() {
+    auto data = lorem_128;
+    auto parser = sl::websocket::frame_parser();
+    auto window = sl::io::span<char>(nullptr, 0);
+    auto result = std::string();
+    size_t pos = 0;
+    // 7-byte windows
+    while (!parser.is_complete()) {
+        auto len = data.length() - pos < 7 ? data.length() - pos : 7;
+        pos += parser.feed_in_place({std::addressof(data.front()) + pos, len}, window);
+        result.append(window.data(), window.size());
+    }
+    slassert(lorem_128.length() == pos);
+    slassert(lorem_128_plain == result);
+}
+
+void test_large_length() {
+    auto sink = sl::io::null_sink();
+    auto parser = sl::websocket::frame_parser();
+    auto head = sl::io::string_from_hex("827f0000000140000000");
+    slassert(head.length() == parser.feed(head, sink));
+    slassert(parser.is_header_complete());
+    slassert(5368709120ULL == parser.payload_length());
+    slassert(5368709120ULL == parser.bytes_needed());
+    auto chunk = std::string(4096, 'a');
+    parser.feed(chunk, sink);
+    slassert(4096 == parser.payload_bytes_read());
+    slassert(5368709120ULL - 4096 == parser.bytes_needed());
+    parser.reset();
+    auto msb = sl::io::string_from_hex("827f8000000000000000");
+    parser.feed(msb, sink);
+    slassert(!parser.is_well_formed());
+}
+
+bool accepted_by_server(const std::string& hex, uint8_t allowed_rsv = 0) {
+    auto sink = sl::io::null_sink();
+    auto parser = sl::websocket::server_frame_parser(allowed_rsv);
+    parser.feed(sl::io::string_from_hex(hex), sink);
+    return parser.is_well_formed();
+}
+
+bool accepted_by_client(const std::string& hex) {
+    auto sink = sl::io::null_sink();
+    auto parser = sl::websocket::client_frame_parser();
+    parser.feed(sl::io::string_from_hex(hex), sink);
+    return parser.is_well_formed();
+}
+
+void test_roles() {
+    // masked text
+    slassert(accepted_by_server("81821875fdc8701c"));
+    slassert(!accepted_by_client("81821875fdc8701c"));
+    // unmasked text
+    slassert(!accepted_by_server("81026869"));
+    slassert(accepted_by_client("81026869"));
+    // RSV1 only when negotiated
+    slassert(!accepted_by_server("c1821875fdc8701c"));
+    slassert(accepted_by_server("c1821875fdc8701c", 0x04));
+    // RSV1 on continuation
+    slassert(!accepted_by_server("c0821875fdc8701c", 0x04));
+    // RSV2 never negotiated
+    slassert(!accepted_by_server("a1821875fdc8701c", 0x04));
+    // fragmented ping
+    slassert(!accepted_by_server("09821875fdc8701c"));
+    // ping longer than 125 bytes
+    slassert(!accepted_by_server("89fe0080a2272042"));
+    slassert(accepted_by_server("89fd1875fdc8"));
+    // role-agnostic parser accepts both
+    auto sink = sl::io::null_sink();
+    auto parser = sl::websocket::frame_parser();
+    parser.feed(sl::io::string_from_hex("89fe0080a2272042"), sink);
+    slassert(parser.is_well_formed());
+}
+
+void test_not_well_formed() {
+    auto sink = sl::io::null_sink();
+    auto parser = sl::websocket::frame_parser();
+    auto bad_opcode = sl::io::string_from_hex("8380be8b6908");
+    parser.feed(bad_opcode, sink);
+    slassert(!parser.is_well_formed());
+    slassert(0 == parser.bytes_needed());
+    parser.reset();
+    auto zero_mask = sl::io::string_from_hex("818000000000");
+    parser.feed(zero_mask, sink);
+    slassert(!parser.is_well_formed());
+}
+
+int main() {
+    try {
+        test_bytewise();
+        test_chunks();
+        test_in_place();
+        test_large_length();
+        test_roles();
+        test_not_well_formed();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -20,10 +20,15 @@
 #include <array>
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "staticlib/config/assert.hpp"
 #include "staticlib/io.hpp"
 
+#include "staticlib/websocket/frame_range.hpp"
+#include "staticlib/websocket/masked_payload_sink.hpp"
+
 const std::string empty = sl::io::string_from_hex("8180be8b6908");
 const std::string hi = sl::io::string_from_hex("81821875fdc8701c");
 const std::string lorem_128 = sl::io::string_from_hex("81fe0080a2272042ee485227cf074932d1524d62c6484c2dd007532bd607412fc7530c62c1484e31c7445427d6525262c3434932cb54432bcc400027ce4e546e8254452682434f62c74e5531cf484462d6424d32cd55002bcc444926cb43552cd6075536824b4120cd554562c7530026cd4b4f30c7074d23c5494162c34b4933d7460e62f7530027");
@@ -109,6 +114,75 @@ void test_payload_64() {
     slassert("81ff00000000000100802d5e9603" == frame.header_hex());
 }
 
+void test_unmask_in_place() {
+    auto buf = std::string(lorem_128);
+    auto frame = sl::websocket::frame(buf);
+    slassert(!frame.is_unmasked());
+    auto span = sl::io::make_span(std::addressof(buf.front()), buf.length());
+    auto pl = frame.unmask_in_place(span);
+    slassert(frame.is_unmasked());
+    slassert(frame.is_masked());
+    slassert(lorem_128_plain == std::string(pl.data(), pl.size()));
+    // second call must not unmask again
+    auto pl2 = frame.unmask_in_place(span);
+    slassert(lorem_128_plain == std::string(pl2.data(), pl2.size()));
+    // source returns payload as is
+    auto src = frame.payload_unmasked();
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(src, sink);
+    slassert(lorem_128_plain == sink.get_string());
+    // different buffer
+    auto other = std::string(lorem_128);
+    bool thrown = false;
+    try {
+        frame.unmask_in_place({std::addressof(other.front()), other.length()});
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_range() {
+    auto buf = hi + empty + lorem_128 + hi + lorem_128.substr(0, 7);
+    auto range = sl::websocket::frame_range(buf);
+    auto sizes = std::vector<uint64_t>();
+    auto payloads = std::string();
+    for (auto& rec : range) {
+        slassert(rec.header().is_masked());
+        slassert(sl::websocket::frame_type::text == rec.header().type());
+        sizes.push_back(rec.header().size());
+        auto src = rec.payload_unmasked();
+        auto sink = sl::io::string_sink();
+        sl::io::copy_all(src, sink);
+        payloads += sink.get_string();
+    }
+    slassert(4 == sizes.size());
+    slassert(8 == sizes[0]);
+    slassert(6 == sizes[1]);
+    slassert(136 == sizes[2]);
+    slassert(8 == sizes[3]);
+    slassert("hi" + lorem_128_plain + "hi" == payloads);
+    slassert(range.is_well_formed());
+    slassert(7 == range.remainder().size());
+    slassert(buf.length() - 7 == range.consumed());
+
+    // remainder without iteration
+    auto range2 = sl::websocket::frame_range(buf);
+    slassert(7 == range2.remainder().size());
+
+    // corrupted frame stops the scan
+    auto bad = hi + sl::io::string_from_hex("8380be8b6908") + hi;
+    auto range3 = sl::websocket::frame_range(bad);
+    size_t count = 0;
+    for (auto& rec : range3) {
+        (void) rec;
+        count += 1;
+    }
+    slassert(1 == count);
+    slassert(!range3.is_well_formed());
+    slassert(bad.length() - hi.length() == range3.remainder().size());
+}
+
 void check_incomplete(const std::string& hex) {
     auto st = sl::io::string_from_hex(hex);
     auto frame = sl::websocket::frame(st);
@@ -152,6 +226,84 @@ void test_not_well_formed() {
     check_not_well_formed("818000000000");
 }
 
+// straightforward byte-by-byte decoding, used as a reference for the table-driven one
+sl::websocket::header_status reference_decode(const std::string& data, uint64_t& plen, uint32_t& mask, size_t& hlen) {
+    if (data.length() < 2) {
+        return sl::websocket::header_status::incomplete;
+    }
+    auto b0 = static_cast<uint8_t>(data[0]);
+    auto b1 = static_cast<uint8_t>(data[1]);
+    if (sl::websocket::frame_type::invalid == sl::websocket::make_frame_type(b0 & 0x0f)) {
+        return sl::websocket::header_status::malformed;
+    }
+    size_t ex = 126 == (b1 & 0x7f) ? 2 : (127 == (b1 & 0x7f) ? 8 : 0);
+    bool masked = 0 != (b1 & 0x80);
+    hlen = 2 + ex + (masked ? 4 : 0);
+    if (data.length() < hlen) {
+        return sl::websocket::header_status::incomplete;
+    }
+    plen = 0 == ex ? (b1 & 0x7f) : 0;
+    for (size_t i = 0; i < ex; i++) {
+        plen = (plen << 8) | static_cast<uint8_t>(data[2 + i]);
+    }
+    mask = 0;
+    for (size_t i = 0; masked && i < 4; i++) {
+        mask = (mask << 8) | static_cast<uint8_t>(data[2 + ex + i]);
+    }
+    if (0 != (plen >> 63) || (masked && 0 == mask)) {
+        return sl::websocket::header_status::malformed;
+    }
+    return sl::websocket::header_status::complete;
+}
+
+void test_header_decode() {
+    static_assert(std::is_trivially_copyable<sl::websocket::frame_header>::value, "frame_header");
+    slassert(16 == sizeof(sl::websocket::frame_header));
+    auto tails = std::vector<std::string>{
+        std::string(12, '\x00'),
+        std::string(12, '\x7f'),
+        std::string(12, '\x80'),
+        sl::io::string_from_hex("0001020304050607080900ff")
+    };
+    for (int b0 : {0x00, 0x81, 0x82, 0xc1, 0x03, 0x88, 0x89, 0x8a, 0x8b, 0x0f}) {
+        for (int b1 = 0; b1 < 256; b1++) {
+            for (auto& tail : tails) {
+                auto full = std::string(1, static_cast<char>(b0)) + static_cast<char>(b1) + tail;
+                for (size_t len = 0; len <= full.length(); len++) {
+                    auto data = full.substr(0, len);
+                    uint64_t plen = 0;
+                    uint32_t mask = 0;
+                    size_t hlen = 0;
+                    auto expected = reference_decode(data, plen, mask, hlen);
+                    auto head = sl::websocket::frame_header();
+                    slassert(expected == sl::websocket::frame_header::decode(data, head));
+                    auto fr = sl::websocket::frame(data);
+                    // frame reports invalid 64-bit length before the masking key is received
+                    slassert(sl::websocket::header_status::incomplete == expected ||
+                            (sl::websocket::header_status::complete == expected) == fr.is_well_formed());
+                    if (sl::websocket::header_status::complete == expected) {
+                        slassert(plen == head.payload_length());
+                        slassert(mask == head.mask_value());
+                        slassert(hlen == head.header_length());
+                        slassert(static_cast<uint8_t>(b0) == (static_cast<uint8_t>(head.type()) |
+                                (head.is_final() ? 0x80 : 0) | (head.rsv_bits() << 4)));
+                        slassert(fr.is_header_complete());
+                        slassert(plen == fr.payload_length());
+                        slassert(mask == fr.mask_value());
+                        slassert(hlen == fr.header().size());
+                        slassert(head.is_final() == fr.is_final());
+                        slassert(head.rsv_bits() == fr.rsv_bits());
+                        slassert(head.type() == fr.type());
+                    } else {
+                        slassert(!fr.is_header_complete());
+                        slassert(!fr.is_complete());
+                    }
+                }
+            }
+        }
+    }
+}
+
 void test_make_header() {
     auto buf = std::array<char, 10>();
     // payload_7
@@ -194,15 +346,106 @@ void test_make_header() {
     slassert("817f0000000000010001" == sl::io::string_to_hex({buf.data(), 10}));
 }
 
+void test_large_length() {
+    // 5 GB payload, only the beginning is available
+    auto buf = std::array<char, 10>();
+    auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::binary, 5368709120ULL);
+    slassert("827f0000000140000000" == sl::io::string_to_hex(head));
+    auto data = std::string(head.data(), head.size()) + "abc";
+    auto frame = sl::websocket::frame(data);
+    slassert(frame.is_well_formed());
+    slassert(frame.is_header_complete());
+    slassert(!frame.is_complete());
+    slassert(5368709120ULL == frame.payload_length());
+    slassert(0 == frame.payload().size());
+    slassert("abc" == std::string(frame.payload_available().data(), frame.payload_available().size()));
+    // most significant bit must be 0
+    check_not_well_formed("827f8000000000000000");
+    bool thrown = false;
+    try {
+        sl::websocket::frame::make_header(buf, sl::websocket::frame_type::binary, 1ULL << 63);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_payload_available() {
+    // masked, header split
+    auto partial = lorem_128.substr(0, 5);
+    auto frame = sl::websocket::frame(partial);
+    slassert(!frame.is_header_complete());
+    slassert(0 == frame.payload_available().size());
+    // masked window in the middle of the payload
+    auto window = lorem_128.substr(0, 8 + 50);
+    auto frame_window = sl::websocket::frame(window);
+    slassert(frame_window.is_header_complete());
+    auto avail = frame_window.payload_available();
+    slassert(50 == avail.size());
+    auto src = sl::websocket::masked_payload_source(avail, frame_window.mask_value());
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(src, sink);
+    slassert(lorem_128_plain.substr(0, 50) == sink.get_string());
+    auto rest = sl::io::make_span(lorem_128.data() + 8 + 50, 78);
+    auto src_rest = sl::websocket::masked_payload_source(rest, frame_window.mask_value(), 50);
+    auto sink_rest = sl::io::string_sink();
+    sl::io::copy_all(src_rest, sink_rest);
+    slassert(lorem_128_plain.substr(50) == sink_rest.get_string());
+}
+
+void test_make_masked() {
+    auto buf = std::array<char, 14>();
+    auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::text, 0, 0xbe8b6908);
+    slassert("8180be8b6908" == sl::io::string_to_hex({head.data(), head.size()}));
+    head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::text, 65664, 0x2d5e9603);
+    slassert("81ff00000000000100802d5e9603" == sl::io::string_to_hex({head.data(), head.size()}));
+    // header + masked payload in one pass
+    auto sink = sl::io::string_sink();
+    head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::text,
+            lorem_128_plain.length(), 0xa2272042);
+    sink.write({head.data(), head.size()});
+    {
+        auto masker = sl::websocket::make_masked_payload_sink(sink, 0xa2272042);
+        // odd-sized writes
+        masker.write({lorem_128_plain.data(), 3});
+        masker.write({lorem_128_plain.data() + 3, lorem_128_plain.length() - 3});
+        slassert(lorem_128_plain.length() == masker.bytes_written());
+    }
+    slassert(lorem_128 == sink.get_string());
+    // masked directly into the send buffer
+    auto sendbuf = std::string(head.data(), head.size()) + std::string(lorem_128_plain.length(), '\0');
+    auto null_sink = sl::io::null_sink();
+    auto masker = sl::websocket::make_masked_payload_sink(null_sink, 0xa2272042);
+    auto dest = sl::io::make_span(std::addressof(sendbuf.front()) + head.size(), lorem_128_plain.length());
+    auto masked = masker.mask_into({lorem_128_plain.data(), 5}, dest);
+    slassert(5 == masked.size());
+    masker.mask_into({lorem_128_plain.data() + 5, lorem_128_plain.length() - 5},
+            {dest.data() + 5, dest.size() - 5});
+    slassert(lorem_128 == sendbuf);
+    bool thrown = false;
+    try {
+        masker.mask_into({lorem_128_plain.data(), 4}, {dest.data(), 3});
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
 int main() {
     try {
         test_empty();
         test_payload_7();
         test_payload_16();
         test_payload_64();
+        test_unmask_in_place();
+        test_range();
         test_incomplete();
         test_not_well_formed();
+        test_header_decode();
         test_make_header();
+        test_make_masked();
+        test_large_length();
+        test_payload_available();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
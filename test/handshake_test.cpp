@@ -23,6 +23,7 @@
 
 #include "staticlib/websocket/handshake.hpp"
 
+#include <array>
 #include <iostream>
 #include <string>
 
@@ -50,12 +51,54 @@ void test_response_headers() {
         }
     }
     slassert("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=" == accept);
+    // keys longer than the stack buffer are still accepted
+    auto long_vec = sl::websocket::handshake::make_response_headers(std::string(200, 'k'));
+    slassert("Sec-WebSocket-Accept" == long_vec.back().first);
+    slassert("HXr7Nbki1tHdEVpq+a7G7IV4VJU=" == long_vec.back().second);
+}
+
+void test_accept_key() {
+    auto accept = std::array<char, sl::websocket::handshake::accept_key_length>();
+    sl::websocket::handshake::make_accept_key(std::string("dGhlIHNhbXBsZSBub25jZQ=="), accept);
+    slassert("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=" == std::string(accept.data(), accept.size()));
+}
+
+void test_write_response() {
+    auto key = std::string("dGhlIHNhbXBsZSBub25jZQ==");
+    auto buf = std::array<char, 256>();
+    auto len = sl::websocket::handshake::write_response(key, buf);
+    slassert(sl::websocket::handshake::response_length() == len);
+    slassert("HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"
+            "\r\n" == std::string(buf.data(), len));
+
+    auto ext = std::string("permessage-deflate");
+    auto len_ext = sl::websocket::handshake::write_response(key, ext, buf);
+    slassert(sl::websocket::handshake::response_length(ext.length()) == len_ext);
+    slassert("HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"
+            "Sec-WebSocket-Extensions: permessage-deflate\r\n"
+            "\r\n" == std::string(buf.data(), len_ext));
+
+    bool thrown = false;
+    try {
+        sl::websocket::handshake::write_response(key, sl::io::make_span(buf.data(), len - 1));
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
 }
 
 int main() {
     try {
         test_request_headers();
         test_response_headers();
+        test_accept_key();
+        test_write_response();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   mask_keys_test.cpp
+ */
+
+#include "staticlib/websocket/mask_keys.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/wait.h>
+#include <unistd.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_encoder.hpp"
+#include "staticlib/websocket/masked_payload_sink.hpp"
+
+void test_chacha20() {
+    // RFC 7539, section 2.3.2
+    auto state = std::array<uint32_t, 16>{{
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+        0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c,
+        0x00000001, 0x09000000, 0x4a000000, 0x00000000
+    }};
+    auto expected = std::array<uint32_t, 16>{{
+        0xe4e7f110, 0x15593bd1, 0x1fdd0f50, 0xc47120a3,
+        0xc7f4d1c7, 0x0368c033, 0x9aaa2204, 0x4e6cd4c3,
+        0x466482d2, 0x09aa9f07, 0x05d7c214, 0xa2028bd9,
+        0xd19c12b5, 0xb94e16de, 0xe883d0cb, 0x4e3c50a2
+    }};
+    auto out = std::array<uint32_t, 16>();
+    sl::websocket::detail_mask::chacha20_block(state, out.data());
+    slassert(expected == out);
+}
+
+void test_keys() {
+    sl::websocket::mask_key_generator gen(1000);
+    auto keys = std::vector<uint32_t>(100000);
+    gen.fill(keys.data(), keys.size());
+    slassert(keys.end() == std::find(keys.begin(), keys.end(), 0));
+    std::sort(keys.begin(), keys.end());
+    auto unique = std::unique(keys.begin(), keys.end()) - keys.begin();
+    // a few birthday collisions are expected
+    slassert(unique > 99900);
+    // different generators are seeded separately
+    sl::websocket::mask_key_generator other;
+    slassert(gen.next() != other.next() || gen.next() != other.next());
+}
+
+void test_threads() {
+    auto keys = std::array<uint32_t, 4>();
+    auto threads = std::vector<std::thread>();
+    for (size_t i = 0; i < keys.size(); i++) {
+        threads.emplace_back([&keys, i] {
+            keys[i] = sl::websocket::next_mask_key();
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+        slassert(0 != keys[i]);
+    }
+    slassert(keys[0] != keys[1] || keys[1] != keys[2]);
+}
+
+void test_encoder() {
+    auto payload = std::string("hello");
+    auto buf = std::array<char, 14>();
+    uint32_t mask = sl::websocket::next_mask_key();
+    slassert(0 != mask);
+    auto head = sl::websocket::frame_encoder<sl::websocket::client_role>::make_header(
+            buf, sl::websocket::frame_type::text, payload.length(), mask);
+    auto sink = sl::io::string_sink();
+    sink.write(head);
+    {
+        auto masker = sl::websocket::make_masked_payload_sink(sink, mask);
+        masker.write({payload.data(), payload.length()});
+    }
+    auto data = sink.get_string();
+    auto fr = sl::websocket::frame({data.data(), data.length()});
+    slassert(fr.is_complete());
+    slassert(fr.is_masked());
+    slassert(fr.conforms_to<sl::websocket::server_role>());
+    auto src = fr.payload_unmasked();
+    auto unmasked = sl::io::string_sink();
+    sl::io::copy_all(src, unmasked);
+    slassert(payload == unmasked.get_string());
+}
+
+void test_fork() {
+#ifndef STATICLIB_WINDOWS
+    sl::websocket::mask_key_generator gen;
+    // keys buffer is filled before fork
+    slassert(0 != gen.next());
+    int fds[2];
+    slassert(0 == ::pipe(fds));
+    auto pid = ::fork();
+    slassert(-1 != pid);
+    if (0 == pid) {
+        auto key = gen.next();
+        auto written = ::write(fds[1], std::addressof(key), sizeof(key));
+        ::_exit(static_cast<ssize_t>(sizeof(key)) == written ? 0 : 1);
+    }
+    ::close(fds[1]);
+    uint32_t child_key = 0;
+    slassert(static_cast<ssize_t>(sizeof(child_key)) == ::read(fds[0], std::addressof(child_key), sizeof(child_key)));
+    ::close(fds[0]);
+    int status = -1;
+    slassert(pid == ::waitpid(pid, std::addressof(status), 0));
+    slassert(0 == status);
+    // child must not repeat the buffered keys of the parent
+    slassert(child_key != gen.next());
+#endif // !STATICLIB_WINDOWS
+}
+
+int main() {
+    try {
+        test_chacha20();
+        test_keys();
+        test_threads();
+        test_encoder();
+        test_fork();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   masking_test.cpp
+ */
+
+#include "staticlib/websocket/masking.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/masked_payload_source.hpp"
+
+const uint32_t mask = 0xa2272042;
+
+std::string create_data(size_t len) {
+    auto res = std::string();
+    for (size_t i = 0; i < len; i++) {
+        res.push_back(static_cast<char>((i * 7 + 3) & 0xff));
+    }
+    return res;
+}
+
+std::string mask_bytewise(const std::string& data, size_t offset) {
+    auto res = std::string();
+    for (size_t i = 0; i < data.length(); i++) {
+        auto shift = (3 - ((offset + i) % 4)) * 8;
+        auto mask_byte = static_cast<char>((mask >> shift) & 0xff);
+        res.push_back(data[i] ^ mask_byte);
+    }
+    return res;
+}
+
+void test_apply_mask() {
+    for (size_t len = 0; len < 300; len++) {
+        auto data = create_data(len);
+        for (size_t offset = 0; offset < 8; offset++) {
+            auto expected = mask_bytewise(data, offset);
+            auto dest = std::string(len, '\0');
+            sl::websocket::apply_mask(data.data(), std::addressof(dest.front()), len, mask, offset);
+            slassert(expected == dest);
+            // in-place
+            sl::websocket::apply_mask(dest.data(), std::addressof(dest.front()), len, mask, offset);
+            slassert(data == dest);
+        }
+    }
+}
+
+void test_odd_reads() {
+    auto data = create_data(1031);
+    auto masked = mask_bytewise(data, 0);
+    for (size_t buf_len = 1; buf_len < 70; buf_len += 3) {
+        auto src = sl::websocket::masked_payload_source({masked.data(), masked.length()}, mask);
+        auto sink = sl::io::string_sink();
+        auto buf = std::string(buf_len, '\0');
+        for (;;) {
+            auto read = src.read({std::addressof(buf.front()), buf.length()});
+            if (std::char_traits<char>::eof() == read) {
+                break;
+            }
+            sink.write({buf.data(), static_cast<size_t>(read)});
+        }
+        slassert(data == sink.get_string());
+    }
+}
+
+int main() {
+    try {
+        test_apply_mask();
+        test_odd_reads();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
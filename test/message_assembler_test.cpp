@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   message_assembler_test.cpp
+ */
+
+#include "staticlib/websocket/message_assembler.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/masked_payload_sink.hpp"
+
+const std::string lorem_128_plain = std::string("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut e");
+
+std::string make_frame(sl::websocket::frame_type ft, const std::string& payload, bool partial) {
+    uint32_t mask = 0x1875fdc8;
+    auto buf = std::array<char, 14>();
+    auto head = sl::websocket::frame::make_header(buf, ft, payload.length(), mask, partial);
+    auto sink = sl::io::string_sink();
+    sink.write({head.data(), head.size()});
+    auto masker = sl::websocket::make_masked_payload_sink(sink, mask);
+    masker.write({payload.data(), payload.length()});
+    return sink.get_string();
+}
+
+sl::websocket::message_status accept(sl::websocket::message_assembler& ma, const std::string& data) {
+    auto fr = sl::websocket::frame(data);
+    slassert(fr.is_complete());
+    return ma.accept(fr);
+}
+
+void test_fragmented() {
+    auto pool = sl::websocket::segment_pool(16);
+    auto ma = sl::websocket::message_assembler(pool, 1024);
+    auto first = make_frame(sl::websocket::frame_type::text, lorem_128_plain.substr(0, 5), true);
+    auto second = make_frame(sl::websocket::frame_type::continuation, lorem_128_plain.substr(5, 50), true);
+    auto ping = make_frame(sl::websocket::frame_type::ping, "ping", false);
+    auto third = make_frame(sl::websocket::frame_type::continuation, lorem_128_plain.substr(55), false);
+    slassert(sl::websocket::message_status::incomplete == accept(ma, first));
+    slassert(sl::websocket::message_status::incomplete == accept(ma, second));
+    slassert(sl::websocket::message_status::control == accept(ma, ping));
+    slassert(sl::websocket::message_status::complete == accept(ma, third));
+    slassert(ma.is_complete());
+    slassert(sl::websocket::frame_type::text == ma.type());
+    slassert(128 == ma.size());
+    slassert(8 == ma.segment_count());
+    auto sink = sl::io::string_sink();
+    ma.write_to(sink);
+    slassert(lorem_128_plain == sink.get_string());
+    auto flat = std::string(128, '\0');
+    auto span = ma.flatten({std::addressof(flat.front()), flat.length()});
+    slassert(128 == span.size());
+    slassert(lorem_128_plain == flat);
+    // segments are reused
+    ma.clear();
+    slassert(8 == pool.cached_count());
+    slassert(sl::websocket::message_status::complete == accept(ma,
+            make_frame(sl::websocket::frame_type::binary, "hi", false)));
+    slassert(7 == pool.cached_count());
+    slassert(sl::websocket::frame_type::binary == ma.type());
+    slassert("hi" == std::string(ma.segment(0).data(), ma.segment(0).size()));
+}
+
+void test_errors() {
+    auto pool = sl::websocket::segment_pool(16);
+    auto ma = sl::websocket::message_assembler(pool, 100);
+    slassert(sl::websocket::message_status::protocol_error == accept(ma,
+            make_frame(sl::websocket::frame_type::continuation, "foo", false)));
+    slassert(sl::websocket::message_status::incomplete == accept(ma,
+            make_frame(sl::websocket::frame_type::text, "foo", true)));
+    slassert(sl::websocket::message_status::protocol_error == accept(ma,
+            make_frame(sl::websocket::frame_type::text, "bar", false)));
+    slassert(0 == ma.size());
+    slassert(sl::websocket::message_status::too_big == accept(ma,
+            make_frame(sl::websocket::frame_type::text, lorem_128_plain, false)));
+    slassert(0 == ma.size());
+    // truncated payload is not appended
+    slassert(sl::websocket::message_status::incomplete == accept(ma,
+            make_frame(sl::websocket::frame_type::text, "foo", true)));
+    auto truncated = make_frame(sl::websocket::frame_type::continuation, "bar", false);
+    truncated.resize(truncated.length() - 1);
+    auto fr = sl::websocket::frame(truncated);
+    slassert(!fr.is_complete());
+    slassert(sl::websocket::message_status::protocol_error == ma.accept(fr));
+    slassert(0 == ma.size());
+}
+
+int main() {
+    try {
+        test_fragmented();
+        test_errors();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   outbound_queue_test.cpp
+ */
+
+#include "staticlib/websocket/outbound_queue.hpp"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+
+struct decoded {
+    sl::websocket::frame_type type;
+    bool final;
+    std::string payload;
+};
+
+// writes out the batch and parses the frames back
+std::vector<decoded> drain(sl::websocket::vectored_encoder<8>& batch) {
+    auto data = std::string();
+    for (size_t i = 0; i < batch.count(); i++) {
+        auto seg = batch.segment(i);
+        data.append(seg.data(), seg.size());
+    }
+    batch.consume(batch.size());
+    auto res = std::vector<decoded>();
+    size_t pos = 0;
+    while (pos < data.length()) {
+        auto fr = sl::websocket::frame({data.data() + pos, data.length() - pos});
+        slassert(fr.is_complete());
+        auto pl = fr.payload();
+        res.push_back({fr.type(), fr.is_final(), std::string(pl.data(), pl.size())});
+        pos += static_cast<size_t>(fr.size());
+    }
+    return res;
+}
+
+void test_priority() {
+    sl::websocket::outbound_queue<8> queue;
+    slassert(queue.empty());
+    slassert(queue.push(sl::websocket::frame_type::text, sl::io::make_span("foo", 3)));
+    slassert(!queue.push(sl::websocket::frame_type::binary, sl::io::make_span("bar", 3)));
+    slassert(!queue.push(sl::websocket::frame_type::pong, sl::io::make_span("ka", 2)));
+    slassert(!queue.push(sl::websocket::make_encoded_frame(sl::websocket::frame_type::text, sl::io::make_span("baz", 3))));
+    slassert(4 == queue.size());
+    slassert(13 == queue.bytes());
+    sl::websocket::vectored_encoder<8> batch;
+    slassert(4 == queue.fill(batch));
+    slassert(queue.empty());
+    auto frames = drain(batch);
+    slassert(4 == frames.size());
+    slassert(sl::websocket::frame_type::pong == frames[0].type);
+    slassert("ka" == frames[0].payload);
+    slassert(sl::websocket::frame_type::text == frames[1].type);
+    slassert("foo" == frames[1].payload);
+    slassert("bar" == frames[2].payload);
+    slassert("baz" == frames[3].payload);
+    // empty queue
+    slassert(0 == queue.fill(batch));
+    // invalid control frame
+    bool thrown = false;
+    try {
+        queue.push(sl::websocket::frame_type::ping, std::string(126, 'a'));
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_fragments() {
+    sl::websocket::outbound_queue<8> queue(1024, std::chrono::microseconds(0), 4);
+    queue.push(sl::websocket::frame_type::text, std::string("0123456789"));
+    queue.push(sl::websocket::frame_type::text, std::string("ab"));
+    sl::websocket::vectored_encoder<8> batch;
+    // first fragment, then ping arrives
+    slassert(4 == queue.fill(batch));
+    auto frames = drain(batch);
+    slassert(4 == frames.size());
+    slassert(sl::websocket::frame_type::text == frames[0].type);
+    slassert(!frames[0].final);
+    slassert("0123" == frames[0].payload);
+    slassert(sl::websocket::frame_type::continuation == frames[1].type);
+    slassert("4567" == frames[1].payload);
+    slassert(frames[2].final);
+    slassert("89" == frames[2].payload);
+    slassert("ab" == frames[3].payload);
+    // control frame between fragments
+    sl::websocket::outbound_queue<8> small(4, std::chrono::microseconds(0), 4);
+    small.push(sl::websocket::frame_type::binary, std::string(12, 'x'));
+    slassert(1 == small.fill(batch));
+    slassert(!drain(batch)[0].final);
+    small.push(sl::websocket::frame_type::ping, sl::io::make_span("p", 1));
+    // next fragment does not fit into the budget after the ping
+    slassert(1 == small.fill(batch));
+    frames = drain(batch);
+    slassert(sl::websocket::frame_type::ping == frames[0].type);
+    slassert(1 == small.fill(batch));
+    frames = drain(batch);
+    slassert(sl::websocket::frame_type::continuation == frames[0].type);
+    slassert(!frames[0].final);
+    slassert(1 == small.fill(batch));
+    frames = drain(batch);
+    slassert(frames[0].final);
+    slassert(small.empty());
+}
+
+void test_coalescing() {
+    sl::websocket::outbound_queue<8> queue(16, std::chrono::microseconds(1000000));
+    queue.push(sl::websocket::frame_type::text, std::string(5, 'a'));
+    auto now = std::chrono::steady_clock::now();
+    // below byte budget and within latency budget
+    slassert(!queue.flush_due(now));
+    slassert(queue.flush_due(now + std::chrono::seconds(2)));
+    queue.push(sl::websocket::frame_type::text, std::string(5, 'b'));
+    queue.push(sl::websocket::frame_type::text, std::string(5, 'c'));
+    queue.push(sl::websocket::frame_type::text, std::string(5, 'd'));
+    slassert(queue.flush_due(now));
+    // byte budget limits the batch
+    sl::websocket::vectored_encoder<8> batch;
+    slassert(3 == queue.fill(batch));
+    drain(batch);
+    queue.push(sl::websocket::frame_type::text, std::string(10, 'a'));
+    queue.push(sl::websocket::frame_type::text, std::string(10, 'b'));
+    queue.push(sl::websocket::frame_type::text, std::string(10, 'c'));
+    // 'd' and 'a' fit into the budget
+    slassert(2 == queue.fill(batch));
+    // batch must be written before the next fill
+    bool thrown = false;
+    try {
+        queue.fill(batch);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    auto frames = drain(batch);
+    slassert(std::string(5, 'd') == frames[0].payload);
+    slassert(std::string(10, 'a') == frames[1].payload);
+    // message larger than the remaining budget goes into the next batch
+    slassert(1 == queue.fill(batch));
+    drain(batch);
+    slassert(1 == queue.fill(batch));
+    // control frame is due immediately
+    drain(batch);
+    queue.push(sl::websocket::frame_type::pong, sl::io::make_span("", 0));
+    slassert(queue.flush_due(now));
+}
+
+void test_producers() {
+    const size_t producers = 4;
+    const size_t count = 2000;
+    sl::websocket::outbound_queue<8> queue(64);
+    auto threads = std::vector<std::thread>();
+    for (size_t p = 0; p < producers; p++) {
+        threads.emplace_back([&queue, p, count] {
+            for (size_t i = 0; i < count; i++) {
+                auto msg = sl::support::to_string(p) + ":" + sl::support::to_string(i);
+                if (0 == i % 100) {
+                    queue.push(sl::websocket::frame_type::ping, std::move(msg));
+                } else {
+                    queue.push(sl::websocket::frame_type::text, std::move(msg));
+                }
+            }
+        });
+    }
+    auto next = std::vector<size_t>(producers, 0);
+    size_t received = 0;
+    size_t batches = 0;
+    sl::websocket::vectored_encoder<8> batch;
+    while (received < producers * count) {
+        if (0 == queue.fill(batch)) {
+            std::this_thread::yield();
+            continue;
+        }
+        batches += 1;
+        for (auto& fr : drain(batch)) {
+            auto colon = fr.payload.find(':');
+            auto p = static_cast<size_t>(std::stoi(fr.payload.substr(0, colon)));
+            auto i = static_cast<size_t>(std::stoi(fr.payload.substr(colon + 1)));
+            if (sl::websocket::frame_type::text == fr.type) {
+                // data messages of each producer keep their order
+                slassert(i > next[p]);
+                next[p] = i;
+            }
+            received += 1;
+        }
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(queue.empty());
+    slassert(0 == queue.bytes());
+    slassert(batches < received);
+}
+
+int main() {
+    try {
+        test_priority();
+        test_fragments();
+        test_coalescing();
+        test_producers();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   permessage_deflate_test.cpp
+ */
+
+#include "staticlib/websocket/permessage_deflate.hpp"
+
+#include <cstring>
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/handshake.hpp"
+
+std::string compress(sl::websocket::deflate_context& ctx, const std::string& msg) {
+    auto sink = sl::io::string_sink();
+    auto deflater = sl::websocket::make_deflate_sink(sink, ctx);
+    deflater.write({msg.data(), msg.length()});
+    deflater.finish();
+    return sink.get_string();
+}
+
+std::string decompress(sl::websocket::inflate_context& ctx, const std::string& data) {
+    auto sink = sl::io::string_sink();
+    auto inflater = sl::websocket::make_inflate_sink(sink, ctx);
+    // odd-sized writes
+    for (size_t i = 0; i < data.length(); i += 3) {
+        auto len = data.length() - i < 3 ? data.length() - i : 3;
+        inflater.write({data.data() + i, len});
+    }
+    inflater.finish();
+    return sink.get_string();
+}
+
+void test_rfc_example() {
+    // RFC 7692, section 7.2.3.1
+    auto ctx = sl::websocket::deflate_context();
+    auto compressed = compress(ctx, "Hello");
+    slassert("f248cdc9c90700" == sl::io::string_to_hex(compressed));
+    auto buf = std::array<char, 10>();
+    auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::text,
+            compressed.length(), false, false, true);
+    slassert("c107" == sl::io::string_to_hex({head.data(), head.size()}));
+    auto wire = std::string(head.data(), head.size()) + compressed;
+    auto fr = sl::websocket::frame(wire);
+    slassert(fr.is_complete());
+    slassert(fr.is_compressed());
+    slassert(4 == fr.rsv_bits());
+    auto ictx = sl::websocket::inflate_context();
+    auto sink = sl::io::string_sink();
+    {
+        auto inflater = sl::websocket::make_inflate_sink(sink, ictx);
+        auto src = fr.payload_unmasked();
+        sl::io::copy_all(src, inflater);
+        inflater.finish();
+    }
+    slassert("Hello" == sink.get_string());
+}
+
+void test_context_takeover() {
+    auto msg = std::string("{\"symbol\":\"FOO\",\"bid\":100.25,\"ask\":100.5}");
+    auto ctx = sl::websocket::deflate_context();
+    auto ictx = sl::websocket::inflate_context();
+    auto first = compress(ctx, msg);
+    auto second = compress(ctx, msg);
+    // second message refers to the first one
+    slassert(second.length() < first.length());
+    slassert(msg == decompress(ictx, first));
+    slassert(msg == decompress(ictx, second));
+
+    auto ctx_nt = sl::websocket::deflate_context(15, true);
+    auto ictx_nt = sl::websocket::inflate_context(15, true);
+    auto first_nt = compress(ctx_nt, msg);
+    auto second_nt = compress(ctx_nt, msg);
+    slassert(first_nt == second_nt);
+    slassert(msg == decompress(ictx_nt, first_nt));
+    slassert(msg == decompress(ictx_nt, second_nt));
+}
+
+void test_large() {
+    auto msg = std::string();
+    for (size_t i = 0; i < 100000; i++) {
+        msg.push_back(static_cast<char>('a' + (i * 31 + i / 7) % 26));
+    }
+    auto params = sl::websocket::deflate_params();
+    params.server_max_window_bits = 10;
+    auto ctx = sl::websocket::deflate_context(params, true);
+    auto ictx = sl::websocket::inflate_context(params, false);
+    slassert(msg == decompress(ictx, compress(ctx, msg)));
+    slassert(msg == decompress(ictx, compress(ctx, msg)));
+    // size limit
+    auto ictx_limited = sl::websocket::inflate_context();
+    auto sink = sl::io::null_sink();
+    auto inflater = sl::websocket::make_inflate_sink(sink, ictx_limited, 1000);
+    bool thrown = false;
+    try {
+        auto compressed = compress(ctx, msg);
+        inflater.write({compressed.data(), compressed.length()});
+        inflater.finish();
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_compressed_frame() {
+    auto msg = std::string("Hello Hello Hello Hello");
+    auto dctx = sl::websocket::deflate_context(15, true);
+    auto fr1 = sl::websocket::make_compressed_frame(dctx, sl::websocket::frame_type::text, msg);
+    auto fr2 = sl::websocket::make_compressed_frame(dctx, sl::websocket::frame_type::text, msg);
+    // no context takeover - same bytes for the same message
+    slassert(fr1->size() == fr2->size());
+    slassert(0 == std::memcmp(fr1->data().data(), fr2->data().data(), fr1->size()));
+    slassert(0 != (fr1->data().data()[0] & 0x40));
+    auto ictx = sl::websocket::inflate_context();
+    auto pl = fr1->payload();
+    slassert(msg == decompress(ictx, std::string(pl.data(), pl.size())));
+}
+
+void test_window_bits() {
+    // zlib cannot compress with 256 bytes window
+    bool thrown = false;
+    try {
+        auto ctx = sl::websocket::deflate_context(8);
+        (void) ctx;
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    auto ctx = sl::websocket::deflate_context(9);
+    auto ictx = sl::websocket::inflate_context(9);
+    auto msg = std::string("{\"symbol\":\"FOO\",\"bid\":100.25,\"ask\":100.5}");
+    msg += msg;
+    slassert(msg == decompress(ictx, compress(ctx, msg)));
+}
+
+void test_negotiate() {
+    auto config = sl::websocket::deflate_params();
+    config.server_no_context_takeover = true;
+    config.client_max_window_bits = 12;
+    auto agreed = sl::websocket::deflate_params();
+    // unknown param in first offer
+    auto resp = sl::websocket::handshake::negotiate_deflate(
+            "permessage-deflate; foo=1, permessage-deflate; client_max_window_bits; server_max_window_bits=10",
+            config, agreed);
+    slassert("permessage-deflate; server_no_context_takeover; server_max_window_bits=10; client_max_window_bits=12" == resp);
+    slassert(agreed.server_no_context_takeover);
+    slassert(!agreed.client_no_context_takeover);
+    slassert(10 == agreed.server_max_window_bits);
+    slassert(12 == agreed.client_max_window_bits);
+    // client side
+    auto client_agreed = sl::websocket::deflate_params();
+    slassert(sl::websocket::handshake::parse_deflate_response(resp, client_agreed));
+    slassert(client_agreed.server_no_context_takeover);
+    slassert(10 == client_agreed.server_max_window_bits);
+    slassert(12 == client_agreed.client_max_window_bits);
+    // client_max_window_bits in response must have a value allowed by the offer
+    slassert(!sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; client_max_window_bits", client_agreed));
+    slassert(!sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; client_max_window_bits=8", client_agreed));
+    slassert(!sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; client_max_window_bits=10", "permessage-deflate", client_agreed));
+    slassert(!sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; client_max_window_bits=12",
+            "permessage-deflate; client_max_window_bits=10", client_agreed));
+    slassert(sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; client_max_window_bits=9",
+            "permessage-deflate; client_max_window_bits=10", client_agreed));
+    slassert(9 == client_agreed.client_max_window_bits);
+    // server_max_window_bits in response must not exceed the offered value
+    slassert(!sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; server_max_window_bits=12",
+            "permessage-deflate; server_max_window_bits=10", client_agreed));
+    slassert(sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; server_max_window_bits=10",
+            "permessage-deflate; server_max_window_bits=10", client_agreed));
+    slassert(10 == client_agreed.server_max_window_bits);
+    slassert(sl::websocket::handshake::parse_deflate_response(
+            "permessage-deflate; server_max_window_bits=12",
+            "permessage-deflate; server_max_window_bits=10, permessage-deflate", client_agreed));
+    slassert(12 == client_agreed.server_max_window_bits);
+    // no client_max_window_bits in offer
+    resp = sl::websocket::handshake::negotiate_deflate("permessage-deflate", config, agreed);
+    slassert("permessage-deflate; server_no_context_takeover" == resp);
+    slassert(15 == agreed.client_max_window_bits);
+    // not supported
+    slassert(sl::websocket::handshake::negotiate_deflate("x-webkit-deflate-frame", config, agreed).empty());
+    slassert(sl::websocket::handshake::negotiate_deflate("permessage-deflate; server_max_window_bits=8",
+            config, agreed).empty());
+    slassert(sl::websocket::handshake::negotiate_deflate("permessage-deflate; server_max_window_bits=16",
+            config, agreed).empty());
+    // offer
+    slassert("permessage-deflate; client_max_window_bits" ==
+            sl::websocket::handshake::make_deflate_offer());
+    auto offer_params = sl::websocket::deflate_params();
+    offer_params.client_max_window_bits = 8;
+    bool thrown = false;
+    try {
+        sl::websocket::handshake::make_deflate_offer(offer_params);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    auto vec = sl::websocket::handshake::make_response_headers("dGhlIHNhbXBsZSBub25jZQ==", resp);
+    slassert("Sec-WebSocket-Extensions" == vec.back().first);
+}
+
+int main() {
+    try {
+        test_rfc_example();
+        test_context_takeover();
+        test_large();
+        test_compressed_frame();
+        test_window_bits();
+        test_negotiate();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   ring_buffer_test.cpp
+ */
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_WINDOWS
+
+#include "staticlib/websocket/ring_buffer.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_range.hpp"
+
+std::string make_frame(size_t payload_len, char fill) {
+    auto payload = std::string(payload_len, fill);
+    auto buf = std::array<char, 10>();
+    auto head = sl::websocket::frame::make_header(buf, sl::websocket::frame_type::binary, payload_len);
+    return std::string(head.data(), head.size()) + payload;
+}
+
+void test_mirror() {
+    auto rb = sl::websocket::ring_buffer(100);
+    slassert(rb.capacity() >= 100);
+    slassert(rb.empty());
+    slassert(rb.capacity() == rb.available());
+    auto cap = rb.capacity();
+    // emptied buffer is rewound
+    rb.commit(cap - 10);
+    rb.consume(cap - 10);
+    slassert(rb.empty());
+    slassert(cap == rb.reserve().size());
+    // write across the end of the buffer
+    rb.commit(cap - 10);
+    rb.consume(cap - 20);
+    slassert(10 == rb.size());
+    auto span = rb.reserve(30);
+    std::memset(span.data(), 'a', span.size());
+    rb.commit(30);
+    slassert(40 == rb.size());
+    // wrapped data is contiguous
+    auto data = rb.data();
+    slassert(std::string(30, 'a') == std::string(data.data() + 10, 30));
+    // and is visible at the start of the buffer
+    rb.consume(30);
+    slassert(std::string(10, 'a') == std::string(rb.data().data(), rb.data().size()));
+    slassert(cap - 10 == rb.available());
+
+    bool thrown = false;
+    try {
+        rb.reserve(cap);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    thrown = false;
+    try {
+        rb.consume(rb.size() + 1);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_wrapped_frame() {
+    auto rb = sl::websocket::ring_buffer(4096);
+    auto cap = rb.capacity();
+    auto stream = make_frame(300, 'x') + make_frame(125, 'y');
+    // frames are written 100 bytes before the end of the buffer,
+    // one byte is kept, so the buffer is not rewound
+    rb.commit(cap - 100);
+    rb.consume(cap - 101);
+    auto span = rb.reserve(stream.length());
+    std::memcpy(span.data(), stream.data(), stream.length());
+    rb.commit(stream.length());
+    rb.consume(1);
+    auto range = sl::websocket::frame_range(rb.data());
+    size_t count = 0;
+    for (auto& rec : range) {
+        auto pl = rec.payload();
+        auto expected = 0 == count ? std::string(300, 'x') : std::string(125, 'y');
+        slassert(expected == std::string(pl.data(), pl.size()));
+        count += 1;
+    }
+    slassert(2 == count);
+    rb.consume(range.consumed());
+    slassert(rb.empty());
+}
+
+void test_recv() {
+    auto fds = std::array<int, 2>();
+    slassert(0 == ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()));
+    auto rb = sl::websocket::ring_buffer(4096);
+    auto stream = std::string();
+    for (size_t i = 0; i < 20; i++) {
+        stream += make_frame(1000, static_cast<char>('a' + i));
+    }
+    size_t received_frames = 0;
+    size_t wrapped = 0;
+    // stream is sent in chunks, that do not match frame boundaries
+    for (size_t pos = 0; pos < stream.length(); pos += 700) {
+        size_t len = std::min(static_cast<size_t>(700), stream.length() - pos);
+        slassert(static_cast<ssize_t>(len) == ::write(fds[0], stream.data() + pos, len));
+        auto space = rb.reserve();
+        struct iovec iov;
+        iov.iov_base = space.data();
+        iov.iov_len = space.size();
+        auto read = ::readv(fds[1], &iov, 1);
+        slassert(static_cast<ssize_t>(len) == read);
+        rb.commit(static_cast<size_t>(read));
+        if (rb.reserve().data() < rb.data().data()) {
+            wrapped += 1;
+        }
+        auto range = sl::websocket::frame_range(rb.data());
+        for (auto& rec : range) {
+            auto pl = rec.payload();
+            slassert(1000 == pl.size());
+            slassert(std::string(1000, static_cast<char>('a' + received_frames)) == std::string(pl.data(), pl.size()));
+            received_frames += 1;
+        }
+        rb.consume(range.consumed());
+    }
+    slassert(20 == received_frames);
+    slassert(wrapped > 0);
+    slassert(rb.empty());
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+void test_move() {
+    auto rb = sl::websocket::ring_buffer(1);
+    rb.commit(5);
+    auto moved = std::move(rb);
+    slassert(5 == moved.size());
+    slassert(0 == rb.capacity());
+}
+
+int main() {
+    try {
+        test_mirror();
+        test_wrapped_frame();
+        test_recv();
+        test_move();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+#else // STATICLIB_WINDOWS
+
+int main() {
+    return 0;
+}
+
+#endif // !STATICLIB_WINDOWS
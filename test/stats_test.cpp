@@ -0,0 +1,180 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   stats_test.cpp
+ */
+
+#define STATICLIB_WEBSOCKET_ENABLE_STATS
+
+#include "staticlib/websocket/stats.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/frame_header.hpp"
+#include "staticlib/websocket/frame_parser.hpp"
+#include "staticlib/websocket/frame_range.hpp"
+#include "staticlib/websocket/handshake.hpp"
+#include "staticlib/websocket/upgrade_request.hpp"
+
+namespace st = sl::websocket::stats;
+
+uint64_t delta(const st::snapshot_type& before, st::counter cn) {
+    return st::snapshot().get(cn) - before.get(cn);
+}
+
+void test_frame() {
+    slassert(st::enabled());
+    auto before = st::snapshot();
+    // masked "Hello"
+    auto data = sl::io::string_from_hex("818537fa213d7f9f4d5158");
+    auto fr = sl::websocket::frame(data);
+    slassert(fr.is_complete());
+    auto sink = sl::io::string_sink();
+    auto src = fr.payload_unmasked();
+    sl::io::copy_all(src, sink);
+    slassert("Hello" == sink.get_string());
+    slassert(1 == delta(before, st::counter::frames_text));
+    slassert(5 == delta(before, st::counter::bytes_unmasked));
+    // incomplete header
+    auto partial = sl::websocket::frame({data.data(), 3});
+    slassert(!partial.is_header_complete());
+    slassert(1 == delta(before, st::counter::headers_incomplete));
+    // zero mask
+    auto zero_mask = sl::io::string_from_hex("818500000000");
+    auto zm = sl::websocket::frame(zero_mask);
+    slassert(!zm.is_well_formed());
+    slassert(1 == delta(before, st::counter::rejected_zero_mask));
+}
+
+void test_parser() {
+    auto before = st::snapshot();
+    auto parser = sl::websocket::server_frame_parser();
+    auto sink = sl::io::null_sink();
+    auto data = sl::io::string_from_hex("898537fa213d7f9f4d5158");
+    slassert(1 == parser.feed({data.data(), 1}, sink));
+    slassert(data.length() - 1 == parser.feed({data.data() + 1, data.length() - 1}, sink));
+    slassert(parser.is_complete());
+    slassert(1 == delta(before, st::counter::frames_ping));
+    slassert(1 == delta(before, st::counter::headers_incomplete));
+    slassert(5 == delta(before, st::counter::bytes_unmasked));
+    // unmasked frame is rejected by server
+    parser.reset();
+    auto unmasked = sl::io::string_from_hex("810548656c6c6f");
+    parser.feed({unmasked.data(), unmasked.length()}, sink);
+    slassert(!parser.is_well_formed());
+    slassert(1 == delta(before, st::counter::rejected_role));
+    // invalid opcode
+    parser.reset();
+    auto bad_opcode = sl::io::string_from_hex("838537fa213d");
+    parser.feed({bad_opcode.data(), bad_opcode.length()}, sink);
+    slassert(1 == delta(before, st::counter::rejected_opcode));
+}
+
+void test_header() {
+    auto before = st::snapshot();
+    auto head = sl::websocket::frame_header();
+    auto data = sl::io::string_from_hex("827f8000000000000000");
+    slassert(sl::websocket::header_status::malformed == sl::websocket::frame_header::decode(data, head));
+    slassert(1 == delta(before, st::counter::rejected_length));
+    auto pong = sl::io::string_from_hex("8a00");
+    slassert(sl::websocket::header_status::complete == sl::websocket::frame_header::decode(pong, head));
+    slassert(1 == delta(before, st::counter::frames_pong));
+}
+
+void test_range() {
+    auto before = st::snapshot();
+    // two pongs and incomplete ping header
+    auto data = sl::io::string_from_hex("8a008a0089");
+    auto range = sl::websocket::frame_range(data);
+    size_t count = 0;
+    for (auto& rec : range) {
+        (void) rec;
+        count += 1;
+    }
+    slassert(2 == count);
+    slassert(1 == range.remainder().size());
+    slassert(1 == range.remainder().size());
+    slassert(2 == delta(before, st::counter::frames_pong));
+    slassert(1 == delta(before, st::counter::headers_incomplete));
+}
+
+void test_handshake() {
+    auto before = st::snapshot();
+    auto request = std::string() +
+            "GET /chat HTTP/1.1\r\n" +
+            "Host: server.example.com\r\n" +
+            "Upgrade: websocket\r\n" +
+            "Connection: Upgrade\r\n" +
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n" +
+            "Sec-WebSocket-Version: 13\r\n" +
+            "\r\n";
+    auto req = sl::websocket::handshake::upgrade_request();
+    auto status = sl::websocket::handshake::parse_request(request, req);
+    slassert(sl::websocket::handshake::request_status::complete == status);
+    auto invalid = std::string("GET /chat HTTP/1.1\r\nHost: a\r\n\r\n");
+    auto invalid_req = sl::websocket::handshake::upgrade_request();
+    sl::websocket::handshake::parse_request(invalid, invalid_req);
+    auto accept = std::array<char, sl::websocket::handshake::accept_key_length>();
+    sl::websocket::handshake::make_accept_key(req.key, accept);
+    slassert(1 == delta(before, st::counter::handshake_requests));
+    slassert(1 == delta(before, st::counter::handshake_rejected));
+    slassert(1 == delta(before, st::counter::accept_keys));
+}
+
+void test_threads() {
+    auto before = st::snapshot();
+    auto data = sl::io::string_from_hex("820548656c6c6f");
+    auto th = std::thread([&data] {
+        for (size_t i = 0; i < 10; i++) {
+            auto fr = sl::websocket::frame(data);
+            slassert(fr.is_complete());
+        }
+    });
+    th.join();
+    // counters of the finished thread are retained
+    slassert(10 == delta(before, st::counter::frames_binary));
+}
+
+void test_json() {
+    auto json = st::snapshot().to_json();
+    slassert(0 == json.find("{\"frames_continuation\": "));
+    slassert(std::string::npos != json.find("\"accept_keys\": "));
+    slassert('}' == json.back());
+}
+
+int main() {
+    try {
+        test_frame();
+        test_parser();
+        test_header();
+        test_range();
+        test_handshake();
+        test_threads();
+        test_json();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
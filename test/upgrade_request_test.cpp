@@ -0,0 +1,140 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   upgrade_request_test.cpp
+ */
+
+#include "staticlib/websocket/upgrade_request.hpp"
+
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+
+namespace hs = sl::websocket::handshake;
+
+const std::string request = std::string() +
+        "GET /chat?room=1 HTTP/1.1\r\n" +
+        "Host: server.example.com\r\n" +
+        "Upgrade: websocket\r\n" +
+        "Connection: keep-alive, Upgrade\r\n" +
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n" +
+        "Origin: http://example.com\r\n" +
+        "Sec-WebSocket-Protocol: chat, superchat\r\n" +
+        "Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits\r\n" +
+        "Sec-WebSocket-Extensions: x-webkit-deflate-frame\r\n" +
+        "sec-websocket-version:13\r\n" +
+        "\r\n";
+
+std::string str(sl::io::span<const char> span) {
+    return std::string(span.data(), span.size());
+}
+
+void test_parse() {
+    auto data = request + "\x81\x00";
+    auto status = hs::request_status::incomplete;
+    auto req = hs::parse_request(data, status);
+    slassert(hs::request_status::complete == status);
+    slassert("GET" == str(req.method));
+    slassert("/chat?room=1" == str(req.target));
+    slassert("HTTP/1.1" == str(req.http_version));
+    slassert("server.example.com" == str(req.host));
+    slassert("websocket" == str(req.upgrade));
+    slassert("keep-alive, Upgrade" == str(req.connection));
+    slassert("dGhlIHNhbXBsZSBub25jZQ==" == str(req.key));
+    slassert("13" == str(req.version));
+    slassert(1 == req.protocols.count);
+    slassert("chat, superchat" == str(req.protocols.values[0]));
+    slassert(2 == req.extensions.count);
+    slassert("permessage-deflate; client_max_window_bits" == str(req.extensions.values[0]));
+    slassert("x-webkit-deflate-frame" == str(req.extensions.values[1]));
+    slassert(request.length() == req.head_length);
+    // spans point into the input
+    slassert(req.key.data() > data.data() && req.key.data() < data.data() + data.length());
+}
+
+void test_incremental() {
+    auto req = hs::upgrade_request();
+    for (size_t i = 0; i < request.length(); i++) {
+        auto status = hs::parse_request({request.data(), i}, req);
+        slassert(hs::request_status::incomplete == status);
+    }
+    auto status = hs::parse_request(request, req);
+    slassert(hs::request_status::complete == status);
+    slassert("dGhlIHNhbXBsZSBub25jZQ==" == str(req.key));
+}
+
+void test_tokens() {
+    auto list = std::string(" chat ,, superchat,");
+    auto span = sl::io::span<const char>(list.data(), list.length());
+    auto token = sl::io::span<const char>(nullptr, 0);
+    slassert(hs::next_token(span, token));
+    slassert("chat" == str(token));
+    slassert(hs::next_token(span, token));
+    slassert("superchat" == str(token));
+    slassert(!hs::next_token(span, token));
+    slassert(hs::has_token(list, "SuperChat"));
+    slassert(!hs::has_token(list, "super"));
+}
+
+void test_invalid() {
+    auto status = hs::request_status::incomplete;
+    // not websocket
+    hs::parse_request(std::string("GET / HTTP/1.1\r\nHost: a\r\n\r\n"), status);
+    slassert(hs::request_status::invalid_upgrade == status);
+    // wrong version
+    auto ver = request;
+    ver.replace(ver.find(":13"), 3, ":8 ");
+    hs::parse_request(ver, status);
+    slassert(hs::request_status::invalid_upgrade == status);
+    // no upgrade token in connection
+    auto conn = request;
+    conn.replace(conn.find("keep-alive, Upgrade"), 19, "keep-alive         ");
+    hs::parse_request(conn, status);
+    slassert(hs::request_status::invalid_upgrade == status);
+    // bad request line
+    hs::parse_request(std::string("GET /\r\nHost: a\r\n\r\n"), status);
+    slassert(hs::request_status::malformed == status);
+    // bad header
+    hs::parse_request(std::string("GET / HTTP/1.1\r\nHo st: a\r\n\r\n"), status);
+    slassert(hs::request_status::malformed == status);
+    // duplicate key
+    auto dup = request;
+    dup.insert(dup.find("Origin"), "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n");
+    hs::parse_request(dup, status);
+    slassert(hs::request_status::malformed == status);
+    // empty lines
+    hs::parse_request(std::string("\n\r\n\r\n"), status);
+    slassert(hs::request_status::malformed == status);
+    // too large
+    auto req = hs::upgrade_request();
+    auto large = std::string(64, 'a');
+    slassert(hs::request_status::malformed == hs::parse_request(large, req, 32));
+}
+
+int main() {
+    try {
+        test_parse();
+        test_incremental();
+        test_tokens();
+        test_invalid();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
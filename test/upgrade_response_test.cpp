@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   upgrade_response_test.cpp
+ */
+
+#include "staticlib/websocket/upgrade_response.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "staticlib/config/assert.hpp"
+
+namespace hs = sl::websocket::handshake;
+
+const std::string key = "dGhlIHNhbXBsZSBub25jZQ==";
+
+const std::string response = std::string() +
+        "HTTP/1.1 101 Switching Protocols\r\n" +
+        "Upgrade: websocket\r\n" +
+        "Connection: Upgrade\r\n" +
+        "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n" +
+        "Sec-WebSocket-Protocol: chat\r\n" +
+        "\r\n";
+
+std::string str(sl::io::span<const char> span) {
+    return std::string(span.data(), span.size());
+}
+
+void test_parse() {
+    auto data = response + "\x81\x02hi";
+    auto resp = hs::upgrade_response();
+    auto status = hs::parse_response(data, key, resp);
+    slassert(hs::response_status::complete == status);
+    slassert(101 == resp.status_code);
+    slassert("Switching Protocols" == str(resp.reason));
+    slassert("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=" == str(resp.accept));
+    slassert("chat" == str(resp.protocol));
+    slassert(0 == resp.extensions.count);
+    slassert(response.length() == resp.head_length);
+    slassert("\x81\x02hi" == data.substr(resp.head_length));
+}
+
+void test_incremental() {
+    auto resp = hs::upgrade_response();
+    for (size_t i = 0; i < response.length(); i++) {
+        auto status = hs::parse_response({response.data(), i}, key, resp);
+        slassert(hs::response_status::incomplete == status);
+    }
+    slassert(hs::response_status::complete == hs::parse_response(response, key, resp));
+}
+
+void test_written_response() {
+    auto buf = std::array<char, 256>();
+    auto len = hs::write_response(key, buf);
+    auto resp = hs::upgrade_response();
+    slassert(hs::response_status::complete == hs::parse_response({buf.data(), len}, key, resp));
+}
+
+void test_invalid() {
+    auto resp = hs::upgrade_response();
+    // wrong key
+    slassert(hs::response_status::invalid_accept ==
+            hs::parse_response(response, std::string("AQIDBAUGBwgJCgsMDQ4PEA=="), resp));
+    // missing accept
+    auto no_accept = response;
+    no_accept.erase(no_accept.find("Sec-WebSocket-Accept"), 52);
+    resp = hs::upgrade_response();
+    slassert(hs::response_status::invalid_accept == hs::parse_response(no_accept, key, resp));
+    // key is too long
+    resp = hs::upgrade_response();
+    slassert(hs::response_status::invalid_accept ==
+            hs::parse_response(response, std::string(129, 'a'), resp));
+    // not switched
+    resp = hs::upgrade_response();
+    slassert(hs::response_status::rejected == hs::parse_response(
+            std::string("HTTP/1.1 403 Forbidden\r\nContent-Length: 0\r\n\r\n"), key, resp));
+    slassert(403 == resp.status_code);
+    // bad status line
+    resp = hs::upgrade_response();
+    slassert(hs::response_status::malformed == hs::parse_response(
+            std::string("HTTP/1.1 1o1 Switching Protocols\r\n\r\n"), key, resp));
+}
+
+int main() {
+    try {
+        test_parse();
+        test_incremental();
+        test_written_response();
+        test_invalid();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   utf8_validator_test.cpp
+ */
+
+#include "staticlib/websocket/utf8_validator.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/websocket/frame.hpp"
+#include "staticlib/websocket/masking.hpp"
+#include "staticlib/websocket/message_assembler.hpp"
+
+bool validate(const std::string& st) {
+    auto val = sl::websocket::utf8_validator();
+    return val.update(st) && val.is_complete();
+}
+
+bool validate_hex(const std::string& hex) {
+    auto st = sl::io::string_from_hex(hex);
+    // padded input is checked without the chunk boundary
+    auto res = validate(st);
+    slassert(res == validate(st + "abcd"));
+    return res;
+}
+
+void test_valid() {
+    slassert(validate(""));
+    slassert(validate("Hello, World! Lorem ipsum dolor sit amet, consectetur adipiscing elit"));
+    // 2, 3 and 4 bytes
+    slassert(validate_hex("c3a9"));
+    slassert(validate_hex("e6bca2e5ad97"));
+    slassert(validate_hex("f09f9880"));
+    // boundaries
+    slassert(validate_hex("c280"));
+    slassert(validate_hex("dfbf"));
+    slassert(validate_hex("e0a080"));
+    slassert(validate_hex("ed9fbf"));
+    slassert(validate_hex("efbfbf"));
+    slassert(validate_hex("f0908080"));
+    slassert(validate_hex("f48fbfbf"));
+}
+
+void test_invalid() {
+    // stray continuation
+    slassert(!validate_hex("80"));
+    slassert(!validate_hex("41bf"));
+    // overlong
+    slassert(!validate_hex("c0af"));
+    slassert(!validate_hex("c1bf"));
+    slassert(!validate_hex("e09fbf"));
+    slassert(!validate_hex("f08fbfbf"));
+    // surrogates
+    slassert(!validate_hex("eda080"));
+    slassert(!validate_hex("edbfbf"));
+    // above U+10FFFF
+    slassert(!validate_hex("f4908080"));
+    slassert(!validate_hex("f5808080"));
+    slassert(!validate_hex("ff"));
+    // truncated
+    slassert(!validate(sl::io::string_from_hex("e6bc")));
+    slassert(!validate(sl::io::string_from_hex("f09f98")));
+    // invalid after long ASCII run
+    slassert(!validate(std::string(100, 'a') + sl::io::string_from_hex("c0af") + std::string(100, 'a')));
+}
+
+void test_split() {
+    auto text = std::string("Lorem ipsum ") + sl::io::string_from_hex("e6bca2e5ad97f09f9880c3a9") +
+            std::string(40, 'x') + sl::io::string_from_hex("f48fbfbf");
+    for (size_t i = 0; i <= text.length(); i++) {
+        auto val = sl::websocket::utf8_validator();
+        slassert(val.update({text.data(), i}));
+        slassert(val.update({text.data() + i, text.length() - i}));
+        slassert(val.is_complete());
+    }
+}
+
+// client frame, payload is masked with the same kernel the frame uses for unmasking
+// byte-wise DFA as a reference
+bool validate_dfa(const std::string& st) {
+    auto classes = sl::websocket::detail_utf8::byte_classes();
+    auto trans = sl::websocket::detail_utf8::transitions();
+    auto state = sl::websocket::detail_utf8::state_accept;
+    for (char ch : st) {
+        state = trans[state + classes[static_cast<uint8_t>(ch)]];
+    }
+    return sl::websocket::detail_utf8::state_accept == state;
+}
+
+void test_long() {
+    // long inputs go through the vector kernel when it is available
+    auto chars = std::vector<std::string>{"a", "\x7f", "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80", "\xed\x9f\xbf",
+        "\xee\x80\x80", "\xef\xbf\xbf", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf", "\xf3\xbf\xbf\xbf"};
+    uint32_t rnd = 42;
+    auto next = [&rnd]() -> uint32_t {
+        rnd = rnd * 1103515245 + 12345;
+        return (rnd >> 16) & 0x7fff;
+    };
+    for (size_t i = 0; i < 20000; i++) {
+        auto st = std::string();
+        size_t len = 64 + next() % 200;
+        while (st.length() < len) {
+            st += chars[next() % chars.size()];
+        }
+        slassert(validate(st));
+        if (0 != i % 4) {
+            // random byte replaced, removed or added
+            size_t pos = next() % st.length();
+            auto byte = static_cast<char>(0 == i % 3 ? 0x80 + next() % 0x80 : next() % 0x100);
+            switch (i % 3) {
+            case 0: st[pos] = byte; break;
+            case 1: st.erase(pos, 1); break;
+            default: st.insert(pos, 1, byte);
+            }
+        }
+        auto expected = validate_dfa(st);
+        slassert(expected == validate(st));
+        // chunk boundary at random position
+        size_t split = next() % st.length();
+        auto val = sl::websocket::utf8_validator();
+        val.update({st.data(), split});
+        val.update({st.data() + split, st.length() - split});
+        slassert(expected == val.is_complete());
+    }
+    // invalid sequences at the end of the long input
+    auto prefix = std::string(100, 'a') + "\xc3\xa9";
+    slassert(!validate(prefix + "\xc3"));
+    slassert(!validate(prefix + "\xe6\xbc"));
+    slassert(!validate(prefix + "\xf0\x9f\x98"));
+    slassert(!validate(prefix + "\xed\xa0\x80"));
+    slassert(!validate(prefix + "\xf4\x90\x80\x80"));
+    slassert(!validate(prefix + "\xc0\xaf"));
+    slassert(!validate(prefix + "\xe0\x9f\xbf"));
+    slassert(!validate(prefix + "\xf0\x8f\xbf\xbf"));
+    slassert(!validate(prefix + "\xff"));
+    slassert(validate(prefix + "\xf4\x8f\xbf\xbf"));
+}
+
+std::string masked_frame(sl::websocket::frame_type ft, const std::string& payload, bool final) {
+    uint32_t mask = 0x1875fdc8;
+    auto buf = std::array<char, 14>();
+    auto head = sl::websocket::frame::make_header(buf, ft, payload.length(), mask, !final);
+    auto res = std::string(head.data(), head.size()) + payload;
+    sl::websocket::apply_mask(payload.data(), std::addressof(res.front()) + head.size(),
+            payload.length(), mask);
+    return res;
+}
+
+void test_assembler() {
+    auto pool = sl::websocket::segment_pool(16);
+    auto ma = sl::websocket::message_assembler(pool, 1024);
+    auto text = std::string(20, 'a') + sl::io::string_from_hex("e6bca2e5ad97");
+    // code point split between frames
+    auto first = masked_frame(sl::websocket::frame_type::text, text.substr(0, 22), false);
+    auto first_fr = sl::websocket::frame(first);
+    slassert(sl::websocket::message_status::incomplete == ma.accept(first_fr));
+    auto second = masked_frame(sl::websocket::frame_type::continuation, text.substr(22), true);
+    auto second_fr = sl::websocket::frame(second);
+    slassert(sl::websocket::message_status::complete == ma.accept(second_fr));
+    // truncated at the end of message
+    auto truncated = masked_frame(sl::websocket::frame_type::text, text.substr(0, 22), true);
+    auto truncated_fr = sl::websocket::frame(truncated);
+    slassert(sl::websocket::message_status::invalid_utf8 == ma.accept(truncated_fr));
+    // invalid
+    auto invalid = masked_frame(sl::websocket::frame_type::text, sl::io::string_from_hex("eda080"), false);
+    auto invalid_fr = sl::websocket::frame(invalid);
+    slassert(sl::websocket::message_status::invalid_utf8 == ma.accept(invalid_fr));
+    // binary is not validated
+    auto binary = masked_frame(sl::websocket::frame_type::binary, sl::io::string_from_hex("eda080"), true);
+    auto binary_fr = sl::websocket::frame(binary);
+    slassert(sl::websocket::message_status::complete == ma.accept(binary_fr));
+}
+
+void test_sink() {
+    auto val = sl::websocket::utf8_validator();
+    auto data = masked_frame(sl::websocket::frame_type::text, sl::io::string_from_hex("e6bca2e5ad97"), true);
+    auto fr = sl::websocket::frame(data);
+    auto sink = sl::io::string_sink();
+    auto vsink = sl::websocket::make_utf8_validating_sink(sink, val);
+    auto src = fr.payload_unmasked();
+    sl::io::copy_all(src, vsink);
+    slassert(val.is_complete());
+    slassert("e6bca2e5ad97" == sl::io::string_to_hex(sink.get_string()));
+}
+
+void test_decode_payload() {
+    auto cjk = sl::io::string_from_hex("e6bca2e5ad97");
+    for (size_t pos = 0; pos < 200; pos += 7) {
+        auto text = std::string(200, 'a');
+        text.insert(pos, cjk);
+        auto data = masked_frame(sl::websocket::frame_type::text, text, true);
+        auto fr = sl::websocket::frame(data);
+        auto val = sl::websocket::utf8_validator();
+        auto dest = std::string(text.length(), '\0');
+        auto span = fr.decode_payload({std::addressof(dest.front()), dest.length()}, val);
+        slassert(text.length() == span.size());
+        slassert(text == dest);
+        slassert(val.is_complete());
+        // invalid
+        auto bad = std::string(text);
+        bad[pos + 3] = '\xc0';
+        auto bad_data = masked_frame(sl::websocket::frame_type::text, bad, true);
+        auto bad_fr = sl::websocket::frame(bad_data);
+        auto bad_val = sl::websocket::utf8_validator();
+        bad_fr.decode_payload({std::addressof(dest.front()), dest.length()}, bad_val);
+        slassert(bad == dest);
+        slassert(!bad_val.is_valid());
+    }
+}
+
+int main() {
+    try {
+        test_valid();
+        test_invalid();
+        test_split();
+        test_long();
+        test_assembler();
+        test_sink();
+        test_decode_payload();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
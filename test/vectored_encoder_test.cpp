@@ -0,0 +1,145 @@
+/*
+ * Copyright 2026, staticlib_websocket contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* 
+ * File:   vectored_encoder_test.cpp
+ */
+
+#include "staticlib/websocket/vectored_encoder.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/websocket/frame_range.hpp"
+
+std::string gather(const sl::websocket::vectored_encoder<4>& enc) {
+    auto res = std::string();
+    for (size_t i = 0; i < enc.count(); i++) {
+        auto seg = enc.segment(i);
+        res.append(seg.data(), seg.size());
+    }
+    return res;
+}
+
+void test_add() {
+    auto hello = std::string("hello");
+    auto bin = std::string(300, 'x');
+    sl::websocket::vectored_encoder<4> enc;
+    slassert(enc.add(sl::websocket::frame_type::text, hello));
+    slassert(enc.add(sl::websocket::frame_type::binary, bin));
+    slassert(4 == enc.count());
+    // payload is referenced, not copied
+    slassert(hello.data() == enc.segment(1).data());
+    auto data = gather(enc);
+    slassert(enc.size() == data.length());
+    auto range = sl::websocket::frame_range(data);
+    auto recs = std::vector<sl::websocket::frame_range::record>();
+    for (auto& rec : range) {
+        recs.push_back(rec);
+    }
+    slassert(range.is_well_formed());
+    slassert(2 == recs.size());
+    slassert(sl::websocket::frame_type::text == recs[0].header().type());
+    slassert(recs[0].header().is_final());
+    slassert(hello == std::string(recs[0].payload().data(), recs[0].payload().size()));
+    slassert(sl::websocket::frame_type::binary == recs[1].header().type());
+    slassert(300 == recs[1].header().payload_length());
+}
+
+void test_fragmented() {
+    auto msg = std::string("0123456789");
+    sl::websocket::vectored_encoder<4> enc;
+    slassert(!enc.add_fragmented(sl::websocket::frame_type::text, msg, 2));
+    slassert(0 == enc.count());
+    slassert(enc.add_fragmented(sl::websocket::frame_type::text, msg, 3, true));
+    slassert(0 == enc.frames_available());
+    slassert(!enc.add(sl::websocket::frame_type::ping, std::string()));
+    auto data = gather(enc);
+    auto range = sl::websocket::frame_range(data);
+    auto types = std::vector<sl::websocket::frame_type>();
+    auto payload = std::string();
+    for (auto& rec : range) {
+        types.push_back(rec.header().type());
+        slassert((4 == types.size()) == rec.header().is_final());
+        slassert((1 == types.size()) == rec.header().is_compressed());
+        payload.append(rec.payload().data(), rec.payload().size());
+    }
+    slassert(4 == types.size());
+    slassert(sl::websocket::frame_type::text == types[0]);
+    slassert(sl::websocket::frame_type::continuation == types[1]);
+    slassert(sl::websocket::frame_type::continuation == types[3]);
+    slassert(msg == payload);
+}
+
+void test_consume() {
+    auto msg = std::string("hello");
+    sl::websocket::vectored_encoder<4> enc;
+    enc.add(sl::websocket::frame_type::text, msg);
+    enc.add(sl::websocket::frame_type::text, msg);
+    auto expected = gather(enc);
+    auto written = std::string();
+    // write 3 bytes at a time
+    while (!enc.empty()) {
+        auto data = gather(enc);
+        auto len = data.length() < 3 ? data.length() : 3;
+        written.append(data.data(), len);
+        enc.consume(len);
+    }
+    slassert(expected == written);
+    slassert(0 == enc.count());
+    slassert(4 == enc.frames_available());
+    bool thrown = false;
+    try {
+        enc.consume(1);
+    } catch (const sl::websocket::websocket_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+#ifndef STATICLIB_WINDOWS
+void test_iovec() {
+    auto msg = std::string("hello");
+    sl::websocket::vectored_encoder<4> enc;
+    enc.add(sl::websocket::frame_type::binary, msg);
+    enc.add(sl::websocket::frame_type::close, std::string());
+    struct iovec iov[8];
+    auto count = enc.to_iovec(iov, 8);
+    slassert(3 == count);
+    slassert(2 == iov[0].iov_len);
+    slassert(msg.data() == iov[1].iov_base);
+    slassert(5 == iov[1].iov_len);
+    slassert(2 == iov[2].iov_len);
+}
+#endif // !STATICLIB_WINDOWS
+
+int main() {
+    try {
+        test_add();
+        test_fragmented();
+        test_consume();
+#ifndef STATICLIB_WINDOWS
+        test_iovec();
+#endif // !STATICLIB_WINDOWS
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}